@@ -127,12 +127,78 @@ extern void gm_matrix4x4_mul(matrix4x4 dest, matrix4x4 mat); /* Multiply two mat
 extern void gm_matrix3x3_mul_scalar(matrix3x3 dest, gmfloat scalar); /* Multiply matrix by scalar. */
 extern void gm_matrix4x4_mul_scalar(matrix4x4 dest, gmfloat scalar); /* Multiply matrix by scalar. */
 
-extern void gm_matrix3x3_mul_vector(matrix3x3 dest, vector3 vec); /* Multiply matrix by vector. */
-extern void gm_matrix4x4_mul_vector(matrix4x4 dest, vector4 vec); /* Multiply matrix by vector. */
+extern void gm_matrix3x3_mul_vector(matrix3x3 mat, vector3 dest); /* Multiply matrix by vector, the product replaces the vector. */
+extern void gm_matrix4x4_mul_vector(matrix4x4 mat, vector4 dest); /* Multiply matrix by vector, the product replaces the vector. */
 
 extern void gm_matrix3x3_transpose(matrix3x3 dest); /* Transpose matrix. */
 extern void gm_matrix4x4_transpose(matrix4x4 dest); /* Transpose matrix. */
 
+/* ---- Dynamic matrices ----
+Arbitrarily sized matrices, stored column-major like matrix3x3 and matrix4x4.
+Build with make GM_USE_THREADS=1 to let gm_matrixn_threads spread products over several threads. */
+
+typedef struct {
+	unsigned int rows;
+	unsigned int cols;
+	gmfloat *data;
+} matrixn;
+
+#define gm_matrixn_at(mat, row, col) ((mat)->data[(row) + (size_t)(mat)->rows * (col)]) /* Access attribute at row and column. */
+#define gm_matrixn_identity(dest) gm_matrixnvd(dest, 1.0)
+
+extern gmboolean gm_matrixn_create(matrixn *dest, unsigned int rows, unsigned int cols); /* Allocate zeroed matrix, returns GM_FALSE if out of memory. */
+extern void gm_matrixn_destroy(matrixn *dest); /* Free matrix data. */
+
+extern void gm_matrixnv(matrixn *dest, gmfloat val); /* Set matrix attributes to specified value. */
+extern void gm_matrixnvd(matrixn *dest, gmfloat val); /* Set matrices diagonal attributes to specified value. */
+
+extern void gm_matrixn_threads(unsigned int count); /* Set number of threads used by matrix products. */
+
+extern gmboolean gm_matrixn_mul(matrixn *dest, matrixn *mat, matrixn *mat2); /* Multiply two matrices into dest, returns GM_FALSE on mismatched sizes. */
+extern gmboolean gm_matrixn_mul_vector(gmfloat *dest, matrixn *mat, gmfloat *vec); /* Multiply matrix by vector into dest, which must not overlap vec, returns GM_FALSE if dest is vec. */
+extern gmboolean gm_matrixn_transpose(matrixn *dest, matrixn *mat); /* Transpose matrix into dest, returns GM_FALSE on mismatched sizes or if dest shares data with mat. */
+
+extern gmboolean gm_matrixn_lu(matrixn *dest, unsigned int *pivot); /* LU factorize square matrix in place, returns GM_FALSE if singular. */
+extern void gm_matrixn_solve(matrixn *lu, unsigned int *pivot, gmfloat *vec); /* Solve system in place using LU factorization. */
+
+/* ---- Keyframe tracks ----
+Sample many vector3 tracks at once, for animation positions and scales. Keys of a track have
+increasing times; the track remembers the last segment so forward playback avoids a full search. */
+
+typedef enum { GM_INTERP_LINEAR, GM_INTERP_CATMULL_ROM, GM_INTERP_HERMITE } gminterp;
+
+typedef struct {
+	unsigned int count; /* Number of tracks. */
+	unsigned int *offset; /* Index of the first key of each track, count + 1 entries. */
+	unsigned int *cursor; /* Segment each track was last sampled in. */
+	gmfloat *times; /* Key times. */
+	vector3 *values; /* Key values. */
+	vector3 *tangents; /* Key tangents per unit of time, NULL unless created for Hermite tracks. */
+} vector3tracks;
+
+#define gm_vector3tracks_keys(tracks, track) ((tracks)->offset[(track) + 1] - (tracks)->offset[track]) /* Return number of keys in track. */
+#define gm_vector3tracks_time(tracks, track, key) ((tracks)->times[(tracks)->offset[track] + (key)]) /* Access time of key in track. */
+#define gm_vector3tracks_value(tracks, track, key) ((tracks)->values[(tracks)->offset[track] + (key)]) /* Access value of key in track. */
+#define gm_vector3tracks_tangent(tracks, track, key) ((tracks)->tangents[(tracks)->offset[track] + (key)]) /* Access tangent of key in track. */
+
+extern gmboolean gm_vector3tracks_create(vector3tracks *dest, unsigned int count, unsigned int *keys, gmboolean tangents); /* Allocate zeroed tracks with given key counts, returns GM_FALSE if out of memory. */
+extern void gm_vector3tracks_destroy(vector3tracks *dest); /* Free track data. */
+extern void gm_vector3tracks_rewind(vector3tracks *dest); /* Reset key search of all tracks. */
+
+extern gmboolean gm_vector3tracks_sample(vector3tracks *tracks, gmfloat time, gminterp mode, vector3 *dest); /* Sample every track at time, returns GM_FALSE for Hermite without tangents. */
+
+/* ---- Instruction sets ----
+Optimized entry points are bound at load time to the best instruction set of the host.
+Set GMATH_ISA=generic|sse4.1|avx2|avx512 in the environment to force a lower one for testing. */
+
+typedef enum { GM_ISA_GENERIC, GM_ISA_SSE41, GM_ISA_AVX2, GM_ISA_AVX512 } gmisa;
+
+extern void gm_isa_init(void); /* Detect host and bind entry points, runs at load time with GCC. */
+extern gmisa gm_isa(void); /* Return the selected instruction set. */
+extern const char *gm_isa_name(gmisa isa); /* Return name of an instruction set. */
+extern gmboolean gm_isa_supported(gmisa isa); /* Check if host supports an instruction set. */
+extern gmboolean gm_isa_select(gmisa isa); /* Bind entry points to an instruction set, returns GM_FALSE if unsupported. */
+
 /* ---- Comparison procedures ----
 Compare data between variables. */
 
@@ -0,0 +1,113 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+#include "gm_dispatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if GM_USE_DISPATCH && (defined(__x86_64__) || defined(__i386__))
+	#include <cpuid.h>
+	#define GM_CPU_X86 1
+#endif
+
+gm_dispatch_table gm_dispatch = { gm_gemm_generic, gm_gemv_generic };
+
+static gmisa gm_isa_current = GM_ISA_GENERIC;
+
+static const char *gm_isa_names[] = { "generic", "sse4.1", "avx2", "avx512" };
+
+/* ---- CPU detection ----
+Find the best instruction set supported by both the processor and the operating system. */
+
+#if GM_CPU_X86
+static unsigned long long gm_cpu_xgetbv(void) {
+	unsigned int eax, edx;
+	__asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((unsigned long long)edx << 32) | eax;
+}
+#endif
+
+static gmisa gm_cpu_detect(void) {
+	gmisa isa = GM_ISA_GENERIC;
+#if GM_CPU_X86
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return isa;
+	if (ecx & bit_SSE4_1) isa = GM_ISA_SSE41;
+
+	/* AVX state has to be enabled by the operating system (XMM and YMM in XCR0). */
+	if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !(ecx & bit_FMA)) return isa;
+	const unsigned long long xcr0 = gm_cpu_xgetbv();
+	if ((xcr0 & 0x6) != 0x6) return isa;
+
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return isa;
+	if (!(ebx & bit_AVX2)) return isa;
+	isa = GM_ISA_AVX2;
+
+	/* AVX-512 additionally needs opmask and ZMM state (XCR0 bits 5 to 7). */
+	if ((ebx & bit_AVX512F) && (xcr0 & 0xe6) == 0xe6) isa = GM_ISA_AVX512;
+#endif
+	return isa;
+}
+
+/* ---- Instruction set selection ----
+Bind the dispatch table, honouring GMATH_ISA=generic|sse4.1|avx2|avx512 at load time. */
+
+gmboolean gm_isa_supported(gmisa isa) {
+	return isa <= gm_cpu_detect() ? GM_TRUE : GM_FALSE;
+}
+
+gmboolean gm_isa_select(gmisa isa) {
+	if (gm_isa_supported(isa) != GM_TRUE) return GM_FALSE;
+
+	switch (isa) {
+#if GM_USE_DISPATCH
+	case GM_ISA_SSE41:
+		gm_dispatch.gemm = gm_gemm_sse41;
+		gm_dispatch.gemv = gm_gemv_sse41;
+		break;
+	case GM_ISA_AVX2:
+		gm_dispatch.gemm = gm_gemm_avx2;
+		gm_dispatch.gemv = gm_gemv_avx2;
+		break;
+	case GM_ISA_AVX512:
+		gm_dispatch.gemm = gm_gemm_avx512;
+		gm_dispatch.gemv = gm_gemv_avx512;
+		break;
+#endif
+	default:
+		gm_dispatch.gemm = gm_gemm_generic;
+		gm_dispatch.gemv = gm_gemv_generic;
+		break;
+	}
+
+	gm_isa_current = isa;
+	return GM_TRUE;
+}
+
+gmisa gm_isa(void) {
+	return gm_isa_current;
+}
+
+const char *gm_isa_name(gmisa isa) {
+	return isa <= GM_ISA_AVX512 ? gm_isa_names[isa] : "unknown";
+}
+
+
+#ifdef __GNUC__
+__attribute__((constructor))
+#endif
+void gm_isa_init(void) {
+	gmisa isa = gm_cpu_detect();
+
+	/* An override above what the host supports falls back to the best supported set. */
+	const char *env = getenv("GMATH_ISA");
+	if (env != NULL) {
+		for (unsigned char i = 0; i <= GM_ISA_AVX512; i++) {
+			if (strcmp(env, gm_isa_names[i]) == 0 && i <= isa) isa = i;
+		}
+	}
+
+	gm_isa_select(isa);
+}
+
+/*** end of file ***/
@@ -0,0 +1,62 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+/* ---- Internal dispatch ----
+Hot entry points are compiled once per instruction set and bound at load time to the best one the
+host supports. Not part of the public interface. */
+
+#ifndef GM_DISPATCH_H
+#define GM_DISPATCH_H
+
+#include "../include/gmath.h"
+
+/* Keep internal symbols out of the dynamic symbol table of the shared library. */
+#if defined(__GNUC__) && !defined(_WIN32)
+	#define GM_HIDDEN __attribute__((visibility("hidden")))
+#else
+	#define GM_HIDDEN
+#endif
+
+/* Column-major view of C += alpha * A * B. */
+typedef struct {
+	unsigned int m, n, k;
+	gmfloat alpha;
+	const gmfloat *a; size_t lda;
+	const gmfloat *b; size_t ldb;
+	gmfloat *c; size_t ldc;
+} gm_gemm_args;
+
+typedef struct {
+	gmboolean (*gemm)(const gm_gemm_args *args);
+	void (*gemv)(gmfloat *dest, const gmfloat *data, unsigned int rows, unsigned int cols, const gmfloat *vec);
+} gm_dispatch_table;
+
+extern GM_HIDDEN gm_dispatch_table gm_dispatch; /* Implementations bound for the selected instruction set. */
+
+extern GM_HIDDEN void *gm_aligned_alloc(size_t size); /* Allocate cache line aligned memory. */
+extern GM_HIDDEN void gm_aligned_free(void *ptr); /* Free memory from gm_aligned_alloc. */
+
+/* ---- Instruction set variants ----
+Each variant is src/gm_matrixn_kernel.c built with -DGM_ISA=<name> and the matching compiler flags. GM_ISA_NAME suffixes a kernel name with the variant being built. */
+
+#ifndef GM_ISA
+	#define GM_ISA generic
+#endif
+
+#define GM_ISA_CONCAT(name, isa) name##_##isa
+#define GM_ISA_EXPAND(name, isa) GM_ISA_CONCAT(name, isa)
+#define GM_ISA_NAME(name) GM_ISA_EXPAND(name, GM_ISA)
+
+#define GM_ISA_DECLARE(isa) \
+	extern GM_HIDDEN gmboolean gm_gemm_##isa(const gm_gemm_args *args); \
+	extern GM_HIDDEN void gm_gemv_##isa(gmfloat *dest, const gmfloat *data, unsigned int rows, unsigned int cols, const gmfloat *vec);
+
+GM_ISA_DECLARE(generic)
+#if GM_USE_DISPATCH
+GM_ISA_DECLARE(sse41)
+GM_ISA_DECLARE(avx2)
+GM_ISA_DECLARE(avx512)
+#endif
+
+#endif /* GM_DISPATCH_H */
+
+/*** end of file ***/
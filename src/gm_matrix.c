@@ -15,7 +15,7 @@ void gm_matrix3x3v(matrix3x3 dest, gmfloat val) {
 	}
 }
 
-void gm_matrix4x4v(matrix3x3 dest, gmfloat val) {
+void gm_matrix4x4v(matrix4x4 dest, gmfloat val) {
 	for (unsigned char i = 0; i < 16; i++) {
 		dest[i] = val;
 	}
@@ -48,7 +48,7 @@ void gm_matrix4x4_ortho(matrix4x4 dest, gmfloat left, gmfloat right, gmfloat bot
 
 	dest[3] = (left + right) / (left - right);
 	dest[7] = (bottom + top) / (bottom - top);
-	dest[11] = (far + near) / (far - near);
+	dest[11] = (far + near) / (near - far);
 }
 
 void gm_matrix4x4_perspective(matrix4x4 dest, gmfloat fov, gmfloat aspect, gmfloat near, gmfloat far) {
@@ -60,6 +60,7 @@ void gm_matrix4x4_perspective(matrix4x4 dest, gmfloat fov, gmfloat aspect, gmflo
 	dest[10] = (near + far) / (near - far);
 	dest[11] = (2.0 * near * far) / (near - far);
 	dest[14] = -1.0;
+	dest[15] = 0.0;
 }
 
 
@@ -81,14 +82,14 @@ void gm_matrix4x4_translate(matrix4x4 dest, vector3 vec) {
 void gm_matrix3x3_scale(matrix3x3 dest, vector2 vec) {
 	gm_matrix3x3_identity(dest);
 	for (unsigned char i = 0; i < 2; i++) {
-		dest[i + 3 * 1] = vec[i];
+		dest[i + 3 * i] = vec[i];
 	}
 }
 
 void gm_matrix4x4_scale(matrix4x4 dest, vector3 vec) {
 	gm_matrix4x4_identity(dest);
 	for (unsigned char i = 0; i < 3; i++) {
-		dest[i + 4 * 1] = vec[i];
+		dest[i + 4 * i] = vec[i];
 	}
 }
 
@@ -111,17 +112,17 @@ void gm_matrix4x4_rotate(matrix4x4 dest, gmfloat angle, vector3 axis) {
 	register gmfloat omc = 1.0 - c;
 
 	/* TODO: Could be further optimized? */
-	dest[0] = axis[0] * omc + c;
+	dest[0] = axis[0] * axis[0] * omc + c;
 	dest[1] = axis[0] * axis[1] * omc - axis[2] * s;
 	dest[2] = axis[0] * axis[2] * omc + axis[1] * s;
 
 	dest[4] = axis[1] * axis[0] * omc + axis[2] * s;
-	dest[5] = axis[1] * omc + c;
+	dest[5] = axis[1] * axis[1] * omc + c;
 	dest[6] = axis[1] * axis[2] * omc - axis[0] * s;
 
 	dest[8] = axis[0] * axis[2] * omc - axis[1] * s;
 	dest[9] = axis[1] * axis[2] * omc + axis[0] * s;
-	dest[10] = axis[2] * omc + c;
+	dest[10] = axis[2] * axis[2] * omc + c;
 }
 
 /* ---- Matrix arithmetic ----
@@ -197,20 +198,30 @@ void gm_matrix4x4_mul_scalar(matrix4x4 dest, gmfloat scalar) {
 }
 
 
-void gm_matrix3x3_mul_vector(matrix3x3 dest, vector3 vec) {
+void gm_matrix3x3_mul_vector(matrix3x3 mat, vector3 dest) {
+	vector3 product = { 0.0f };
 	for (unsigned char i = 0; i < 3; i++) {
-		for (unsigned char j = 0; j < 3; j++) {
-			dest[i + 3 * j] *= vec[j];
+		for (unsigned char k = 0; k < 3; k++) {
+			product[i] += mat[i + 3 * k] * dest[k];
 		}
 	}
+
+	for (unsigned char i = 0; i < 3; i++) {
+		dest[i] = product[i];
+	}
 }
 
-void gm_matrix4x4_mul_vector(matrix4x4 dest, vector4 vec) {
+void gm_matrix4x4_mul_vector(matrix4x4 mat, vector4 dest) {
+	vector4 product = { 0.0f };
 	for (unsigned char i = 0; i < 4; i++) {
-		for (unsigned char j = 0; j < 4; j++) {
-			dest[i + 4 * j] *= vec[j];
+		for (unsigned char k = 0; k < 4; k++) {
+			product[i] += mat[i + 4 * k] * dest[k];
 		}
 	}
+
+	for (unsigned char i = 0; i < 4; i++) {
+		dest[i] = product[i];
+	}
 }
 
 
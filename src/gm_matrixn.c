@@ -0,0 +1,308 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+#include "gm_dispatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#if GM_USE_THREADS
+	#include <pthread.h>
+#endif
+
+/* ---- Blocking parameters ----
+Panel sizes of the algorithms built on top of the matrix product. Threads split the product into
+column ranges that are a multiple of every register tile width. */
+
+#define GM_LU_NB 64 /* Panel width of the blocked LU factorization. */
+#define GM_TRANSPOSE_BLOCK 32
+#define GM_THREAD_SPLIT 24
+
+#define GM_ALIGN 64
+
+#define gm_min(a, b) ((a) < (b) ? (a) : (b))
+
+static unsigned int gm_thread_count = 1;
+
+/* ---- Aligned buffers ----
+Packing buffers are aligned to a cache line. The original pointer is stored in front of the block. */
+
+void *gm_aligned_alloc(size_t size) {
+	unsigned char *raw = malloc(size + GM_ALIGN + sizeof(void *));
+	if (raw == NULL) return NULL;
+
+	uintptr_t addr = ((uintptr_t)(raw + sizeof(void *)) + GM_ALIGN - 1) & ~(uintptr_t)(GM_ALIGN - 1);
+	((void **)addr)[-1] = raw;
+	return (void *)addr;
+}
+
+void gm_aligned_free(void *ptr) {
+	if (ptr != NULL) free(((void **)ptr)[-1]);
+}
+
+/* ---- Set matrices ----
+Allocate and set matrix data to specified values. */
+
+gmboolean gm_matrixn_create(matrixn *dest, unsigned int rows, unsigned int cols) {
+	dest->rows = rows;
+	dest->cols = cols;
+	dest->data = gm_aligned_alloc((size_t)rows * cols * sizeof(gmfloat));
+	if (dest->data == NULL) {
+		dest->rows = dest->cols = 0;
+		return GM_FALSE;
+	}
+
+	memset(dest->data, 0, (size_t)rows * cols * sizeof(gmfloat));
+	return GM_TRUE;
+}
+
+void gm_matrixn_destroy(matrixn *dest) {
+	gm_aligned_free(dest->data);
+	dest->data = NULL;
+	dest->rows = dest->cols = 0;
+}
+
+
+void gm_matrixnv(matrixn *dest, gmfloat val) {
+	const size_t size = (size_t)dest->rows * dest->cols;
+	for (size_t i = 0; i < size; i++) {
+		dest->data[i] = val;
+	}
+}
+
+void gm_matrixnvd(matrixn *dest, gmfloat val) {
+	gm_matrixnv(dest, 0.0);
+	for (unsigned int i = 0; i < dest->rows && i < dest->cols; i++) {
+		dest->data[i + (size_t)dest->rows * i] = val;
+	}
+}
+
+void gm_matrixn_threads(unsigned int count) {
+	gm_thread_count = count > 0 ? count : 1;
+}
+
+/* ---- Matrix product ----
+C += alpha * A * B through the implementation bound for this host. */
+
+#if GM_USE_THREADS
+static void *gm_gemm_thread(void *args) {
+	return gm_dispatch.gemm(args) ? args : NULL;
+}
+#endif
+
+/* Split the columns of C between worker threads, each packing its own panels. */
+static gmboolean gm_gemm(const gm_gemm_args *args) {
+#if GM_USE_THREADS
+	unsigned int count = gm_thread_count;
+	const unsigned int slivers = (args->n + GM_THREAD_SPLIT - 1) / GM_THREAD_SPLIT;
+	if (count > slivers) count = slivers;
+	if ((double)args->m * args->n * args->k < 64.0 * 64.0 * 64.0) count = 1;
+
+	if (count > 1) {
+		pthread_t threads[count];
+		gm_gemm_args parts[count];
+		gmboolean started[count];
+		gmboolean result = GM_TRUE;
+
+		unsigned int col = 0;
+		for (unsigned int t = 0; t < count; t++) {
+			const unsigned int width = (slivers * (t + 1) / count - slivers * t / count) * GM_THREAD_SPLIT;
+			parts[t] = *args;
+			parts[t].n = gm_min(width, args->n - col);
+			parts[t].b = args->b + args->ldb * col;
+			parts[t].c = args->c + args->ldc * col;
+			col += parts[t].n;
+
+			started[t] = t > 0 && pthread_create(&threads[t], NULL, gm_gemm_thread, &parts[t]) == 0;
+			if (t > 0 && !started[t] && gm_dispatch.gemm(&parts[t]) != GM_TRUE) result = GM_FALSE;
+		}
+
+		if (gm_dispatch.gemm(&parts[0]) != GM_TRUE) result = GM_FALSE;
+		for (unsigned int t = 1; t < count; t++) {
+			void *ret = NULL;
+			if (started[t] && (pthread_join(threads[t], &ret) != 0 || ret == NULL)) result = GM_FALSE;
+		}
+		return result;
+	}
+#endif
+	return gm_dispatch.gemm(args);
+}
+
+/* ---- Matrix arithmetic ----
+Modify properties of matrices using mathematics. */
+
+gmboolean gm_matrixn_mul(matrixn *dest, matrixn *mat, matrixn *mat2) {
+	if (mat->cols != mat2->rows || dest->rows != mat->rows || dest->cols != mat2->cols) return GM_FALSE;
+
+	/* Write into a temporary when the destination overlaps an operand. */
+	matrixn product = *dest;
+	if (dest->data == mat->data || dest->data == mat2->data) {
+		if (gm_matrixn_create(&product, dest->rows, dest->cols) != GM_TRUE) return GM_FALSE;
+	} else {
+		gm_matrixnv(&product, 0.0);
+	}
+
+	const gm_gemm_args args = {
+		mat->rows, mat2->cols, mat->cols, 1.0,
+		mat->data, mat->rows,
+		mat2->data, mat2->rows,
+		product.data, product.rows
+	};
+	gmboolean result = gm_gemm(&args);
+
+	if (product.data != dest->data) {
+		if (result == GM_TRUE) memcpy(dest->data, product.data, (size_t)dest->rows * dest->cols * sizeof(gmfloat));
+		gm_matrixn_destroy(&product);
+	}
+	return result;
+}
+
+
+gmboolean gm_matrixn_mul_vector(gmfloat *dest, matrixn *mat, gmfloat *vec) {
+	if (dest == vec) return GM_FALSE;
+
+	gm_dispatch.gemv(dest, mat->data, mat->rows, mat->cols, vec);
+	return GM_TRUE;
+}
+
+
+gmboolean gm_matrixn_transpose(matrixn *dest, matrixn *mat) {
+	if (dest->rows != mat->cols || dest->cols != mat->rows || dest->data == mat->data) return GM_FALSE;
+
+	/* Copy tile by tile so both the reads and the strided writes stay within cache. */
+	const unsigned int rows = mat->rows, cols = mat->cols;
+	for (unsigned int jb = 0; jb < cols; jb += GM_TRANSPOSE_BLOCK) {
+		const unsigned int je = gm_min(jb + GM_TRANSPOSE_BLOCK, cols);
+		for (unsigned int ib = 0; ib < rows; ib += GM_TRANSPOSE_BLOCK) {
+			const unsigned int ie = gm_min(ib + GM_TRANSPOSE_BLOCK, rows);
+			for (unsigned int j = jb; j < je; j++) {
+				for (unsigned int i = ib; i < ie; i++) {
+					dest->data[j + (size_t)cols * i] = mat->data[i + (size_t)rows * j];
+				}
+			}
+		}
+	}
+	return GM_TRUE;
+}
+
+/* ---- Linear systems ----
+Blocked LU factorization with partial pivoting, L and U are stored in place of the matrix. */
+
+static void gm_lu_swap_rows(gmfloat *data, size_t ld, unsigned int row, unsigned int row2, unsigned int begin, unsigned int end) {
+	for (unsigned int j = begin; j < end; j++) {
+		const gmfloat tmp = data[row + ld * j];
+		data[row + ld * j] = data[row2 + ld * j];
+		data[row2 + ld * j] = tmp;
+	}
+}
+
+gmboolean gm_matrixn_lu(matrixn *dest, unsigned int *pivot) {
+	const unsigned int n = dest->rows;
+	const size_t ld = dest->rows;
+	gmfloat *a = dest->data;
+	gmboolean result = GM_TRUE;
+	if (dest->rows != dest->cols) return GM_FALSE;
+
+	for (unsigned int jb = 0; jb < n; jb += GM_LU_NB) {
+		const unsigned int nb = gm_min(GM_LU_NB, n - jb);
+		const unsigned int je = jb + nb;
+
+		/* Factor the panel with unblocked elimination. */
+		for (unsigned int j = jb; j < je; j++) {
+			unsigned int p = j;
+			gmfloat best = fabs(a[j + ld * j]);
+			for (unsigned int i = j + 1; i < n; i++) {
+				const gmfloat val = fabs(a[i + ld * j]);
+				if (val > best) {
+					best = val;
+					p = i;
+				}
+			}
+			pivot[j] = p;
+			if (p != j) gm_lu_swap_rows(a, ld, j, p, jb, je);
+
+			if (best == 0.0) {
+				result = GM_FALSE;
+				continue;
+			}
+
+			const gmfloat inv = 1.0 / a[j + ld * j];
+			for (unsigned int i = j + 1; i < n; i++) {
+				a[i + ld * j] *= inv;
+			}
+			for (unsigned int k = j + 1; k < je; k++) {
+				const gmfloat u = a[j + ld * k];
+				gmfloat *col = a + ld * k;
+				const gmfloat *l = a + ld * j;
+				for (unsigned int i = j + 1; i < n; i++) {
+					col[i] -= l[i] * u;
+				}
+			}
+		}
+
+		/* Apply the panel's row swaps to the columns on either side. */
+		for (unsigned int j = jb; j < je; j++) {
+			if (pivot[j] == j) continue;
+			gm_lu_swap_rows(a, ld, j, pivot[j], 0, jb);
+			gm_lu_swap_rows(a, ld, j, pivot[j], je, n);
+		}
+		if (je >= n) continue;
+
+		/* U12 = L11^-1 * A12 with the unit lower triangle of the panel. */
+		for (unsigned int k = je; k < n; k++) {
+			gmfloat *col = a + ld * k;
+			for (unsigned int j = jb; j < je; j++) {
+				const gmfloat u = col[j];
+				const gmfloat *l = a + ld * j;
+				for (unsigned int i = j + 1; i < je; i++) {
+					col[i] -= l[i] * u;
+				}
+			}
+		}
+
+		/* A22 -= L21 * U12 */
+		const gm_gemm_args args = {
+			n - je, n - je, nb, -1.0,
+			a + je + ld * jb, ld,
+			a + jb + ld * je, ld,
+			a + je + ld * je, ld
+		};
+		if (gm_gemm(&args) != GM_TRUE) return GM_FALSE;
+	}
+	return result;
+}
+
+void gm_matrixn_solve(matrixn *lu, unsigned int *pivot, gmfloat *vec) {
+	const unsigned int n = lu->rows;
+	const size_t ld = lu->rows;
+	const gmfloat *a = lu->data;
+
+	for (unsigned int i = 0; i < n; i++) {
+		if (pivot[i] != i) {
+			const gmfloat tmp = vec[i];
+			vec[i] = vec[pivot[i]];
+			vec[pivot[i]] = tmp;
+		}
+	}
+
+	/* Forward substitution with the unit lower triangle, column by column. */
+	for (unsigned int j = 0; j < n; j++) {
+		const gmfloat v = vec[j];
+		const gmfloat *col = a + ld * j;
+		for (unsigned int i = j + 1; i < n; i++) {
+			vec[i] -= col[i] * v;
+		}
+	}
+
+	/* Back substitution with the upper triangle. */
+	for (unsigned int j = n; j-- > 0;) {
+		const gmfloat *col = a + ld * j;
+		vec[j] /= col[j];
+		const gmfloat v = vec[j];
+		for (unsigned int i = 0; i < j; i++) {
+			vec[i] -= col[i] * v;
+		}
+	}
+}
+
+/*** end of file ***/
@@ -0,0 +1,195 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+/* Built once per instruction set: GM_ISA names the variant and GM_GEMM_VECTOR_SIZE / GM_GEMM_NR
+size the register tile for it. */
+
+#include "gm_dispatch.h"
+
+#include <string.h>
+
+/* ---- Blocking parameters ----
+Register tile (MR x NR) and cache blocks (MC x KC of the left matrix, KC x NC of the right matrix)
+used by the matrix product. MR spans two vector registers of GM_GEMM_VECTOR_SIZE bytes. */
+
+#ifndef GM_GEMM_VECTOR_SIZE
+	#define GM_GEMM_VECTOR_SIZE 16
+#endif
+
+#ifndef GM_GEMM_NR
+	#define GM_GEMM_NR 4
+#endif
+
+#define GM_GEMM_MR (2 * GM_GEMM_VECTOR_SIZE / (int)sizeof(gmfloat))
+
+#define GM_GEMM_KC 256
+#define GM_GEMM_MC (GM_GEMM_MR * 16)
+#define GM_GEMM_NC (GM_GEMM_NR * 512)
+
+#define gm_min(a, b) ((a) < (b) ? (a) : (b))
+
+/* ---- Matrix product ----
+C += alpha * A * B on column-major views, blocked for the cache hierarchy. Panels of A and B are
+packed into contiguous slivers so the micro kernel streams through memory with unit stride. */
+
+/* Pack an mc x kc block of A into MR-row slivers, zero padding the last one. */
+static void gm_gemm_pack_a(unsigned int mc, unsigned int kc, const gmfloat *a, size_t lda, gmfloat *pack) {
+	for (unsigned int i = 0; i < mc; i += GM_GEMM_MR) {
+		const unsigned int mr = gm_min(GM_GEMM_MR, mc - i);
+		for (unsigned int p = 0; p < kc; p++) {
+			const gmfloat *col = a + i + lda * p;
+			unsigned int r = 0;
+			for (; r < mr; r++) pack[r] = col[r];
+			for (; r < GM_GEMM_MR; r++) pack[r] = 0.0;
+			pack += GM_GEMM_MR;
+		}
+	}
+}
+
+/* Pack a kc x nc block of B into NR-column slivers, zero padding the last one. */
+static void gm_gemm_pack_b(unsigned int kc, unsigned int nc, const gmfloat *b, size_t ldb, gmfloat *pack) {
+	for (unsigned int j = 0; j < nc; j += GM_GEMM_NR) {
+		const unsigned int nr = gm_min(GM_GEMM_NR, nc - j);
+		for (unsigned int p = 0; p < kc; p++) {
+			unsigned int r = 0;
+			for (; r < nr; r++) pack[r] = b[p + ldb * (j + r)];
+			for (; r < GM_GEMM_NR; r++) pack[r] = 0.0;
+			pack += GM_GEMM_NR;
+		}
+	}
+}
+
+/* Multiply an MR-row sliver of A by an NR-column sliver of B, keeping the tile in registers. */
+static void gm_gemm_kernel(unsigned int kc, const gmfloat *restrict a, const gmfloat *restrict b,
+                           gmfloat *c, size_t ldc, unsigned int mr, unsigned int nr, gmfloat alpha) {
+	gmfloat acc[GM_GEMM_NR][GM_GEMM_MR];
+
+#ifdef __GNUC__
+	/* Spell the tile out in vector registers, the packed slivers are aligned to a full register pair. */
+	typedef gmfloat gm_simd __attribute__((vector_size(GM_GEMM_VECTOR_SIZE)));
+	gm_simd lo[GM_GEMM_NR], hi[GM_GEMM_NR];
+
+	#pragma GCC unroll 16
+	for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+		lo[j] = hi[j] = (gm_simd){ 0 };
+	}
+
+	for (unsigned int p = 0; p < kc; p++) {
+		const gm_simd a0 = ((const gm_simd *)a)[0];
+		const gm_simd a1 = ((const gm_simd *)a)[1];
+		#pragma GCC unroll 16
+		for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+			lo[j] += a0 * b[j];
+			hi[j] += a1 * b[j];
+		}
+		a += GM_GEMM_MR;
+		b += GM_GEMM_NR;
+	}
+
+	for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+		memcpy(acc[j], &lo[j], sizeof(gm_simd));
+		memcpy(acc[j] + GM_GEMM_MR / 2, &hi[j], sizeof(gm_simd));
+	}
+#else
+	for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+		for (unsigned int i = 0; i < GM_GEMM_MR; i++) {
+			acc[j][i] = 0.0;
+		}
+	}
+
+	for (unsigned int p = 0; p < kc; p++) {
+		for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+			const gmfloat bj = b[j];
+			for (unsigned int i = 0; i < GM_GEMM_MR; i++) {
+				acc[j][i] += a[i] * bj;
+			}
+		}
+		a += GM_GEMM_MR;
+		b += GM_GEMM_NR;
+	}
+#endif
+
+	if (mr == GM_GEMM_MR && nr == GM_GEMM_NR) {
+		for (unsigned int j = 0; j < GM_GEMM_NR; j++) {
+			for (unsigned int i = 0; i < GM_GEMM_MR; i++) {
+				c[i + ldc * j] += alpha * acc[j][i];
+			}
+		}
+	} else {
+		for (unsigned int j = 0; j < nr; j++) {
+			for (unsigned int i = 0; i < mr; i++) {
+				c[i + ldc * j] += alpha * acc[j][i];
+			}
+		}
+	}
+}
+
+gmboolean GM_ISA_NAME(gm_gemm)(const gm_gemm_args *args) {
+	const unsigned int m = args->m, n = args->n, k = args->k;
+	if (m == 0 || n == 0 || k == 0) return GM_TRUE;
+
+	const unsigned int kc_max = gm_min(GM_GEMM_KC, k);
+	const unsigned int mc_max = gm_min(GM_GEMM_MC, (m + GM_GEMM_MR - 1) / GM_GEMM_MR * GM_GEMM_MR);
+	const unsigned int nc_max = gm_min(GM_GEMM_NC, (n + GM_GEMM_NR - 1) / GM_GEMM_NR * GM_GEMM_NR);
+
+	gmfloat *pack_a = gm_aligned_alloc((size_t)mc_max * kc_max * sizeof(gmfloat));
+	gmfloat *pack_b = gm_aligned_alloc((size_t)nc_max * kc_max * sizeof(gmfloat));
+	if (pack_a == NULL || pack_b == NULL) {
+		gm_aligned_free(pack_a);
+		gm_aligned_free(pack_b);
+		return GM_FALSE;
+	}
+
+	for (unsigned int jc = 0; jc < n; jc += GM_GEMM_NC) {
+		const unsigned int nc = gm_min(GM_GEMM_NC, n - jc);
+		for (unsigned int pc = 0; pc < k; pc += GM_GEMM_KC) {
+			const unsigned int kc = gm_min(GM_GEMM_KC, k - pc);
+			gm_gemm_pack_b(kc, nc, args->b + pc + args->ldb * jc, args->ldb, pack_b);
+
+			for (unsigned int ic = 0; ic < m; ic += GM_GEMM_MC) {
+				const unsigned int mc = gm_min(GM_GEMM_MC, m - ic);
+				gm_gemm_pack_a(mc, kc, args->a + ic + args->lda * pc, args->lda, pack_a);
+
+				for (unsigned int jr = 0; jr < nc; jr += GM_GEMM_NR) {
+					for (unsigned int ir = 0; ir < mc; ir += GM_GEMM_MR) {
+						gm_gemm_kernel(kc, pack_a + (size_t)ir * kc, pack_b + (size_t)jr * kc,
+						               args->c + (ic + ir) + args->ldc * (jc + jr), args->ldc,
+						               gm_min(GM_GEMM_MR, mc - ir), gm_min(GM_GEMM_NR, nc - jr), args->alpha);
+					}
+				}
+			}
+		}
+	}
+
+	gm_aligned_free(pack_a);
+	gm_aligned_free(pack_b);
+	return GM_TRUE;
+}
+
+
+/* ---- Matrix vector product ----
+dest = A * vec, walking four columns at a time so each pass over dest does four multiply-adds per element. */
+
+void GM_ISA_NAME(gm_gemv)(gmfloat *dest, const gmfloat *data, unsigned int rows, unsigned int cols, const gmfloat *vec) {
+	for (unsigned int i = 0; i < rows; i++) {
+		dest[i] = 0.0;
+	}
+
+	unsigned int j = 0;
+	for (; j + 4 <= cols; j += 4) {
+		const gmfloat *c0 = data + (size_t)rows * j;
+		const gmfloat *c1 = c0 + rows, *c2 = c1 + rows, *c3 = c2 + rows;
+		const gmfloat v0 = vec[j], v1 = vec[j + 1], v2 = vec[j + 2], v3 = vec[j + 3];
+		for (unsigned int i = 0; i < rows; i++) {
+			dest[i] += c0[i] * v0 + c1[i] * v1 + c2[i] * v2 + c3[i] * v3;
+		}
+	}
+	for (; j < cols; j++) {
+		const gmfloat *c0 = data + (size_t)rows * j;
+		const gmfloat v0 = vec[j];
+		for (unsigned int i = 0; i < rows; i++) {
+			dest[i] += c0[i] * v0;
+		}
+	}
+}
+
+/*** end of file ***/
@@ -10,7 +10,7 @@
 Compare data between variables. */
 
 gmboolean gm_comp_epsilon(gmfloat f1, gmfloat f2, gmfloat tolerance) {
-	return !(abs(f1 - f2) > tolerance);
+	return !(fabs(f1 - f2) > tolerance);
 }
 
 
@@ -51,14 +51,28 @@ gmboolean gm_matrix4x4_comp_epsilon(matrix4x4 mat, matrix4x4 mat2, gmfloat toler
 }
 
 /* ---- Conversion procedures ----
-Convert data between variables. */
+Convert data between variables. Float builds multiply in double and round once at the end. Double
+builds split the factor into a leading double and the rest, and add the small product in an fma. */
+
+#define GM_DEG_RAD_HI 0x1.1df46a2529d39p-6
+#define GM_DEG_RAD_LO 0x1.5c1d8becdd291p-62
+#define GM_RAD_DEG_HI 0x1.ca5dc1a63c1f8p+5
+#define GM_RAD_DEG_LO -0x1.1e7ab456405f9p-49
 
 gmfloat gm_conv_deg_rad(gmfloat deg) {
-	return deg * M_PI / 180.0f;
+#if GM_USE_DOUBLE
+	return fma(deg, GM_DEG_RAD_HI, deg * GM_DEG_RAD_LO);
+#else
+	return (double)deg * GM_DEG_RAD_HI;
+#endif
 }
 
 gmfloat gm_conv_rad_deg(gmfloat rad) {
-	return 180.0f * M_PI / rad;
+#if GM_USE_DOUBLE
+	return fma(rad, GM_RAD_DEG_HI, rad * GM_RAD_DEG_LO);
+#else
+	return (double)rad * GM_RAD_DEG_HI;
+#endif
 }
 
 /*** end of file  ***/
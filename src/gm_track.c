@@ -0,0 +1,156 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+#include "../include/gmath.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ---- Sampling parameters ----
+A cursor per track makes forward playback a short scan. */
+
+#define GM_TRACK_SCAN 4 /* Keys scanned forward from the cursor before falling back to bisection. */
+
+/* ---- Set tracks ----
+Allocate track storage, keys of all tracks are stored back to back. */
+
+gmboolean gm_vector3tracks_create(vector3tracks *dest, unsigned int count, unsigned int *keys, gmboolean tangents) {
+	memset(dest, 0, sizeof(vector3tracks));
+	dest->count = count;
+	dest->offset = malloc(sizeof(unsigned int) * (count + 1));
+	dest->cursor = calloc(count + 1, sizeof(unsigned int));
+	if (dest->offset == NULL || dest->cursor == NULL) {
+		gm_vector3tracks_destroy(dest);
+		return GM_FALSE;
+	}
+
+	dest->offset[0] = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		dest->offset[i + 1] = dest->offset[i] + keys[i];
+	}
+
+	/* One zeroed key past the end stands in for tracks without keys. */
+	const size_t total = dest->offset[count] + 1;
+	dest->times = calloc(total, sizeof(gmfloat));
+	dest->values = calloc(total, sizeof(vector3));
+	if (tangents == GM_TRUE) dest->tangents = calloc(total, sizeof(vector3));
+	if (dest->times == NULL || dest->values == NULL || (tangents == GM_TRUE && dest->tangents == NULL)) {
+		gm_vector3tracks_destroy(dest);
+		return GM_FALSE;
+	}
+	return GM_TRUE;
+}
+
+void gm_vector3tracks_destroy(vector3tracks *dest) {
+	free(dest->offset);
+	free(dest->cursor);
+	free(dest->times);
+	free(dest->values);
+	free(dest->tangents);
+	memset(dest, 0, sizeof(vector3tracks));
+}
+
+void gm_vector3tracks_rewind(vector3tracks *dest) {
+	memset(dest->cursor, 0, sizeof(unsigned int) * dest->count);
+}
+
+/* ---- Key search ----
+Find segment k < keys - 1 of a track with times[k] <= time, and time < times[k + 1] unless k is the
+last segment, given times[0] <= time <= times[keys - 1]. */
+
+static unsigned int gm_track_search(const gmfloat *times, unsigned int keys, unsigned int cursor, gmfloat time) {
+	unsigned int low, high;
+	if (cursor > keys - 2) cursor = 0;
+
+	if (times[cursor] <= time) {
+		for (unsigned int scan = 0; scan < GM_TRACK_SCAN; scan++) {
+			if (time < times[cursor + 1] || cursor + 2 == keys) return cursor;
+			cursor++;
+		}
+		low = cursor;
+		high = keys - 1;
+	} else {
+		low = 0;
+		high = cursor;
+	}
+
+	while (high - low > 1) {
+		const unsigned int mid = low + (high - low) / 2;
+		if (times[mid] <= time) low = mid;
+		else high = mid;
+	}
+	return low;
+}
+
+/* ---- Sampling ----
+Evaluate every track at the same time into dest, one vector3 per track. Each track is located and
+evaluated in one pass, so the keys of a segment are read once and written straight to dest. */
+
+gmboolean gm_vector3tracks_sample(vector3tracks *tracks, gmfloat time, gminterp mode, vector3 *dest) {
+	const gmfloat *times = tracks->times;
+	const vector3 *values = tracks->values;
+	if (mode == GM_INTERP_HERMITE && tracks->tangents == NULL) return GM_FALSE;
+
+	for (unsigned int track = 0; track < tracks->count; track++) {
+		const unsigned int o = tracks->offset[track], keys = tracks->offset[track + 1] - o;
+		unsigned int k0, k1;
+		gmfloat s;
+
+		/* Locate the segment. The time is clamped to the track instead of branching on the ends, which
+		tracks of different lengths would mispredict. Past the last key, on tracks with a single key,
+		and on empty tracks (the zero key) both ends of the segment are the same key. */
+		if (keys < 2) {
+			k0 = k1 = keys ? o : tracks->offset[tracks->count];
+			s = 0.0;
+		} else {
+			const gmfloat begin = times[o], end = times[o + keys - 1];
+			const gmfloat clamped = time < begin ? begin : (time < end ? time : end);
+			const unsigned int k = gm_track_search(times + o, keys, tracks->cursor[track], clamped);
+			const unsigned int past = clamped >= end;
+			tracks->cursor[track] = k;
+
+			k0 = o + k + past;
+			k1 = o + k + 1;
+			s = past ? 0.0 : (clamped - times[o + k]) / (times[o + k + 1] - times[o + k]);
+		}
+
+		const gmfloat *p0 = values[k0], *p1 = values[k1];
+		if (mode == GM_INTERP_LINEAR || k0 == k1) {
+			for (unsigned int c = 0; c < 3; c++) {
+				dest[track][c] = p0[c] + (p1[c] - p0[c]) * s;
+			}
+			continue;
+		}
+
+		/* Cubic modes: tangents scaled to the segment length, then the Hermite basis. */
+		const gmfloat dt = times[k1] - times[k0];
+		vector3 m0, m1;
+		if (mode == GM_INTERP_HERMITE) {
+			for (unsigned int c = 0; c < 3; c++) {
+				m0[c] = tracks->tangents[k0][c] * dt;
+				m1[c] = tracks->tangents[k1][c] * dt;
+			}
+		} else {
+			/* Catmull-Rom tangents from the neighbouring keys, one sided at the ends of the track. */
+			const unsigned int prev = k0 > o ? k0 - 1 : k0;
+			const unsigned int next = k1 + 1 < o + keys ? k1 + 1 : k1;
+			const gmfloat w0 = dt / (times[k1] - times[prev]);
+			const gmfloat w1 = dt / (times[next] - times[k0]);
+			for (unsigned int c = 0; c < 3; c++) {
+				m0[c] = (p1[c] - values[prev][c]) * w0;
+				m1[c] = (values[next][c] - p0[c]) * w1;
+			}
+		}
+
+		const gmfloat s2 = s * s;
+		const gmfloat s3 = s2 * s;
+		const gmfloat h01 = 3.0f * s2 - 2.0f * s3;
+		const gmfloat h10 = s3 - 2.0f * s2 + s;
+		const gmfloat h11 = s3 - s2;
+		for (unsigned int c = 0; c < 3; c++) {
+			dest[track][c] = p0[c] + (p1[c] - p0[c]) * h01 + m0[c] * h10 + m1[c] * h11;
+		}
+	}
+	return GM_TRUE;
+}
+
+/*** end of file ***/
@@ -12,21 +12,21 @@
 Set vector data to specified values. */
 
 void gm_vector2(vector2 dest, gmfloat x, gmfloat y) {
-	dest[1] = x;
-	dest[2] = y;
+	dest[0] = x;
+	dest[1] = y;
 }
 
 void gm_vector3(vector3 dest, gmfloat x, gmfloat y, gmfloat z) {
-	dest[1] = x;
-	dest[2] = y;
-	dest[3] = z;
+	dest[0] = x;
+	dest[1] = y;
+	dest[2] = z;
 }
 
 void gm_vector4(vector4 dest, gmfloat x, gmfloat y, gmfloat z, gmfloat w) {
-	dest[1] = x;
-	dest[2] = y;
-	dest[3] = z;
-	dest[4] = w;
+	dest[0] = x;
+	dest[1] = y;
+	dest[2] = z;
+	dest[3] = w;
 }
 
 
@@ -84,7 +84,7 @@ void gm_vector3_sub(vector3 dest, vector3 vec) {
 
 void gm_vector4_sub(vector4 dest, vector4 vec) {
 	for (unsigned char i = 0; i < 4; i++) {
-		dest[i] *= vec[i];
+		dest[i] -= vec[i];
 	}
 }
 
@@ -160,9 +160,10 @@ gmfloat gm_vector2_cross(vector2 vec, vector2 vec2) {
 }
 
 void gm_vector3_cross(vector3 dest, vector3 vec) {
-	dest[0] = dest[1] * vec[2] - dest[2] * vec[1];
-	dest[1] = dest[2] * vec[0] - dest[0] * vec[2];
-	dest[2] = dest[0] * vec[1] - dest[1] * vec[0];
+	const gmfloat x = dest[0], y = dest[1], z = dest[2];
+	dest[0] = y * vec[2] - z * vec[1];
+	dest[1] = z * vec[0] - x * vec[2];
+	dest[2] = x * vec[1] - y * vec[0];
 }
 
 
@@ -0,0 +1,1002 @@
+/* Provide simple mathematic functions involving vectors and matrices for use with OpenGL */
+
+/* Differential test harness: runs every GMath function, and every instruction set variant of the
+dispatched ones, against a long double reference over random and edge case inputs. Reports max and
+mean error in ULPs next to throughput, and fails when an error budget is exceeded. */
+
+#include "../include/gmath.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <float.h>
+
+#define GM_TEST_SAMPLES 4096
+#define GM_TEST_MIN_TIME 0.02 /* Seconds each throughput measurement runs for at least. */
+#define GM_TEST_MAX_IN 40
+#define GM_TEST_MAX_OUT 16
+
+#if GM_USE_DOUBLE
+	#define GM_TEST_MAX DBL_MAX
+	#define GM_TEST_MIN DBL_MIN
+	#define GM_TEST_EPSILON DBL_EPSILON
+	#define gm_test_nextafter nextafter
+#else
+	#define GM_TEST_MAX FLT_MAX
+	#define GM_TEST_MIN FLT_MIN
+	#define GM_TEST_EPSILON FLT_EPSILON
+	#define gm_test_nextafter nextafterf
+#endif
+
+typedef long double gmref;
+
+#define GM_TEST_PI 3.14159265358979323846264338327950288L /* M_PI is only a double. */
+
+/* ---- Inputs ----
+Random values with a share of edge cases. FULL covers infinities, NaNs, denormals and extremes for
+element wise functions, SAFE stays clear of intermediate overflow and underflow, ANGLE is in radians. */
+
+typedef enum { GM_TEST_FULL, GM_TEST_SAFE, GM_TEST_ANGLE } gm_test_domain;
+
+static unsigned long long gm_test_state = 0x9e3779b97f4a7c15ULL;
+
+static unsigned long long gm_test_rand(void) {
+	gm_test_state ^= gm_test_state << 13;
+	gm_test_state ^= gm_test_state >> 7;
+	gm_test_state ^= gm_test_state << 17;
+	return gm_test_state;
+}
+
+static double gm_test_uniform(double low, double high) {
+	return low + (high - low) * (double)(gm_test_rand() >> 11) / 9007199254740992.0;
+}
+
+static gmfloat gm_test_value(gm_test_domain domain) {
+	const gmfloat full[] = {
+		0.0, -0.0, 1.0, -1.0, GM_TEST_EPSILON, 1.0 + GM_TEST_EPSILON, GM_TEST_MIN, -GM_TEST_MIN,
+		GM_TEST_MIN / 8.0, GM_TEST_MAX, -GM_TEST_MAX, INFINITY, -INFINITY, NAN
+	};
+	const gmfloat safe[] = { 0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 1e-6, -1e-6, 1e6, -1e6 };
+	const gmfloat angle[] = { 0.0, M_PI_2, M_PI, -M_PI, 2.0 * M_PI, 1e-4, -1e-4 };
+	const int edge = gm_test_rand() % 8 == 0;
+
+	switch (domain) {
+	case GM_TEST_FULL:
+		if (edge) return full[gm_test_rand() % (sizeof(full) / sizeof(full[0]))];
+		return (gm_test_rand() & 1 ? -1.0 : 1.0) * ldexp(gm_test_uniform(1.0, 2.0), (int)(gm_test_rand() % 81) - 40);
+	case GM_TEST_SAFE:
+		if (edge) return safe[gm_test_rand() % (sizeof(safe) / sizeof(safe[0]))];
+		return (gm_test_rand() & 1 ? -1.0 : 1.0) * ldexp(gm_test_uniform(1.0, 2.0), (int)(gm_test_rand() % 41) - 20);
+	default:
+		if (edge) return angle[gm_test_rand() % (sizeof(angle) / sizeof(angle[0]))];
+		return gm_test_uniform(-2.0 * M_PI, 2.0 * M_PI);
+	}
+}
+
+/* ---- Error measurement ----
+Error in units of the last place of the reference. Reductions pass the sum of the magnitudes of
+their terms so cancellation is measured against the size of the inputs, not of the result. */
+
+static double gm_test_ulp(gmfloat got, gmref ref, gmref mag) {
+	const gmfloat rounded = (gmfloat)ref;
+	if (isnan(got) || isnan(rounded)) return isnan(got) && isnan(rounded) ? 0.0 : INFINITY;
+	if (isinf(got) || isinf(rounded)) return got == rounded ? 0.0 : INFINITY;
+
+	const gmref scale = fabsl(ref) > fabsl(mag) ? fabsl(ref) : fabsl(mag);
+	gmfloat base = scale > GM_TEST_MAX ? GM_TEST_MAX : (gmfloat)scale;
+	gmfloat ulp = gm_test_nextafter(base, INFINITY) - base;
+	if (isinf(ulp)) ulp = base - gm_test_nextafter(base, 0.0);
+
+	return (double)(fabsl((gmref)got - ref) / ulp);
+}
+
+/* ---- Report ---- */
+
+static int gm_test_failures = 0;
+
+static void gm_test_header(const char *title) {
+	printf("\n%s\n", title);
+	printf("%-28s %-8s %10s %10s %8s %14s\n", "function", "isa", "max ulp", "mean ulp", "budget", "throughput");
+}
+
+static gmboolean gm_test_report(const char *name, const char *isa, double max, double mean, double budget, double rate, const char *unit) {
+	const gmboolean pass = max <= budget ? GM_TRUE : GM_FALSE;
+	printf("%-28s %-8s %10.2f %10.3f %8.1f %9.1f %-6s%s\n", name, isa, max, mean, budget, rate, unit, pass ? "" : " FAIL");
+	if (!pass) gm_test_failures++;
+	return pass;
+}
+
+/* Count an allocation that failed as a failure instead of running on NULL. */
+static gmboolean gm_test_allocated(const char *name, gmboolean allocated) {
+	if (allocated != GM_TRUE) {
+		printf("%-28s out of memory FAIL\n", name);
+		gm_test_failures++;
+	}
+	return allocated;
+}
+
+static double gm_test_time(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* ---- Fixed size functions ----
+Each case wraps one library call (run) and an independent long double reference (ref) on a flat
+array of inputs. Most entry points work in place, so the wrappers copy the inputs first. */
+
+typedef struct {
+	const char *name;
+	gm_test_domain domain;
+	unsigned int inputs;
+	unsigned int outputs;
+	double budget;
+	void (*run)(gmfloat *out, gmfloat *in);
+	void (*ref)(gmref *out, gmref *mag, const gmfloat *in);
+} gm_test_case;
+
+/* Comparisons are defined on the difference as gmfloat can hold it, ties at the tolerance follow its rounding. */
+static gmref gm_test_distance(gmfloat f1, gmfloat f2) {
+	return fabsl((gmref)(gmfloat)((gmref)f1 - f2));
+}
+
+#define gm_test_copy(dst, src, n) for (unsigned int c_ = 0; c_ < (n); c_++) (dst)[c_] = (src)[c_]
+
+/* Vectors */
+
+#define GM_TEST_VECTOR(n) \
+	static void run_vector##n##v(gmfloat *out, gmfloat *in) { gm_vector##n##v(out, in[0]); } \
+	static void ref_vector##n##v(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) out[i] = in[0]; \
+	} \
+	static void run_vector##n##_add(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n); gm_vector##n##_add(out, in + n); } \
+	static void ref_vector##n##_add(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) out[i] = (gmref)in[i] + in[n + i]; \
+	} \
+	static void run_vector##n##_sub(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n); gm_vector##n##_sub(out, in + n); } \
+	static void ref_vector##n##_sub(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) out[i] = (gmref)in[i] - in[n + i]; \
+	} \
+	static void run_vector##n##_mul(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n); gm_vector##n##_mul(out, in + n); } \
+	static void ref_vector##n##_mul(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) out[i] = (gmref)in[i] * in[n + i]; \
+	} \
+	static void run_vector##n##_mul_scalar(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n); gm_vector##n##_mul_scalar(out, in[n]); } \
+	static void ref_vector##n##_mul_scalar(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) out[i] = (gmref)in[i] * in[n]; \
+	} \
+	static void run_vector##n##_dot(gmfloat *out, gmfloat *in) { out[0] = gm_vector##n##_dot(in, in + n); } \
+	static void ref_vector##n##_dot(gmref *out, gmref *mag, const gmfloat *in) { \
+		out[0] = mag[0] = 0.0; \
+		for (unsigned int i = 0; i < n; i++) { out[0] += (gmref)in[i] * in[n + i]; mag[0] += fabsl((gmref)in[i] * in[n + i]); } \
+	} \
+	static void run_vector##n##_length_sq(gmfloat *out, gmfloat *in) { out[0] = gm_vector##n##_length_sq(in); } \
+	static void ref_vector##n##_length_sq(gmref *out, gmref *mag, const gmfloat *in) { \
+		out[0] = 0.0; \
+		for (unsigned int i = 0; i < n; i++) out[0] += (gmref)in[i] * in[i]; \
+	} \
+	static void run_vector##n##_length(gmfloat *out, gmfloat *in) { out[0] = gm_vector##n##_length(in); } \
+	static void ref_vector##n##_length(gmref *out, gmref *mag, const gmfloat *in) { \
+		ref_vector##n##_length_sq(out, mag, in); \
+		out[0] = sqrtl(out[0]); \
+	} \
+	static void run_vector##n##_distance(gmfloat *out, gmfloat *in) { out[0] = gm_vector##n##_distance(in, in + n); } \
+	static void ref_vector##n##_distance(gmref *out, gmref *mag, const gmfloat *in) { \
+		out[0] = 0.0; \
+		for (unsigned int i = 0; i < n; i++) out[0] += ((gmref)in[i] - in[n + i]) * ((gmref)in[i] - in[n + i]); \
+		out[0] = sqrtl(out[0]); \
+	} \
+	static void run_vector##n##_normalized(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n); gm_vector##n##_normalized(out); } \
+	static void ref_vector##n##_normalized(gmref *out, gmref *mag, const gmfloat *in) { \
+		gmref length; \
+		ref_vector##n##_length(&length, mag, in); \
+		for (unsigned int i = 0; i < n; i++) out[i] = in[i] / length; \
+	} \
+	static void run_vector##n##_comp_epsilon(gmfloat *out, gmfloat *in) { out[0] = gm_vector##n##_comp_epsilon(in, in + n, fabs(in[2 * n])); } \
+	static void ref_vector##n##_comp_epsilon(gmref *out, gmref *mag, const gmfloat *in) { \
+		out[0] = 1.0; \
+		mag[0] = 1.0; \
+		for (unsigned int i = 0; i < n; i++) if (gm_test_distance(in[i], in[n + i]) > fabsl(in[2 * n])) out[0] = 0.0; \
+	}
+
+GM_TEST_VECTOR(2)
+GM_TEST_VECTOR(3)
+GM_TEST_VECTOR(4)
+
+static void run_vector2(gmfloat *out, gmfloat *in) { gm_vector2(out, in[0], in[1]); }
+static void run_vector3(gmfloat *out, gmfloat *in) { gm_vector3(out, in[0], in[1], in[2]); }
+static void run_vector4(gmfloat *out, gmfloat *in) { gm_vector4(out, in[0], in[1], in[2], in[3]); }
+static void ref_copy(gmref *out, gmref *mag, const gmfloat *in) {
+	for (unsigned int i = 0; i < GM_TEST_MAX_OUT; i++) out[i] = in[i];
+}
+
+static void run_vector2_cross(gmfloat *out, gmfloat *in) { out[0] = gm_vector2_cross(in, in + 2); }
+static void ref_vector2_cross(gmref *out, gmref *mag, const gmfloat *in) {
+	out[0] = (gmref)in[0] * in[3] - (gmref)in[1] * in[2];
+	mag[0] = fabsl((gmref)in[0] * in[3]) + fabsl((gmref)in[1] * in[2]);
+}
+
+static void run_vector3_cross(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, 3); gm_vector3_cross(out, in + 3); }
+static void ref_vector3_cross(gmref *out, gmref *mag, const gmfloat *in) {
+	for (unsigned int i = 0; i < 3; i++) {
+		const unsigned int j = (i + 1) % 3, k = (i + 2) % 3;
+		out[i] = (gmref)in[j] * in[3 + k] - (gmref)in[k] * in[3 + j];
+		mag[i] = fabsl((gmref)in[j] * in[3 + k]) + fabsl((gmref)in[k] * in[3 + j]);
+	}
+}
+
+/* Matrices */
+
+#define GM_TEST_MATRIX(n) \
+	static void run_matrix##n##v(gmfloat *out, gmfloat *in) { gm_matrix##n##x##n##v(out, in[0]); } \
+	static void ref_matrix##n##v(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = in[0]; \
+	} \
+	static void run_matrix##n##vd(gmfloat *out, gmfloat *in) { gm_matrix##n##x##n##vd(out, in[0]); } \
+	static void ref_matrix##n##vd(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = i % (n + 1) == 0 ? in[0] : 0.0; \
+	} \
+	static void run_matrix##n##_add(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n * n); gm_matrix##n##x##n##_add(out, in + n * n); } \
+	static void ref_matrix##n##_add(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = (gmref)in[i] + in[n * n + i]; \
+	} \
+	static void run_matrix##n##_sub(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n * n); gm_matrix##n##x##n##_sub(out, in + n * n); } \
+	static void ref_matrix##n##_sub(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = (gmref)in[i] - in[n * n + i]; \
+	} \
+	static void run_matrix##n##_mul(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n * n); gm_matrix##n##x##n##_mul(out, in + n * n); } \
+	static void ref_matrix##n##_mul(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) { \
+			for (unsigned int j = 0; j < n; j++) { \
+				out[i + n * j] = mag[i + n * j] = 0.0; \
+				for (unsigned int k = 0; k < n; k++) { \
+					out[i + n * j] += (gmref)in[i + n * k] * in[n * n + k + n * j]; \
+					mag[i + n * j] += fabsl((gmref)in[i + n * k] * in[n * n + k + n * j]); \
+				} \
+			} \
+		} \
+	} \
+	static void run_matrix##n##_mul_scalar(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n * n); gm_matrix##n##x##n##_mul_scalar(out, in[n * n]); } \
+	static void ref_matrix##n##_mul_scalar(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = (gmref)in[i] * in[n * n]; \
+	} \
+	static void run_matrix##n##_mul_vector(gmfloat *out, gmfloat *in) { gm_test_copy(out, in + n * n, n); gm_matrix##n##x##n##_mul_vector(in, out); } \
+	static void ref_matrix##n##_mul_vector(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n; i++) { \
+			out[i] = mag[i] = 0.0; \
+			for (unsigned int k = 0; k < n; k++) { \
+				out[i] += (gmref)in[i + n * k] * in[n * n + k]; \
+				mag[i] += fabsl((gmref)in[i + n * k] * in[n * n + k]); \
+			} \
+		} \
+	} \
+	static void run_matrix##n##_transpose(gmfloat *out, gmfloat *in) { gm_test_copy(out, in, n * n); gm_matrix##n##x##n##_transpose(out); } \
+	static void ref_matrix##n##_transpose(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = in[i / n + n * (i % n)]; \
+	} \
+	static void run_matrix##n##_translate(gmfloat *out, gmfloat *in) { gm_matrix##n##x##n##_translate(out, in); } \
+	static void ref_matrix##n##_translate(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = i % (n + 1) == 0 ? 1.0 : 0.0; \
+		for (unsigned int i = 0; i < n - 1; i++) out[n - 1 + n * i] = in[i]; \
+	} \
+	static void run_matrix##n##_scale(gmfloat *out, gmfloat *in) { gm_matrix##n##x##n##_scale(out, in); } \
+	static void ref_matrix##n##_scale(gmref *out, gmref *mag, const gmfloat *in) { \
+		for (unsigned int i = 0; i < n * n; i++) out[i] = i % (n + 1) == 0 ? 1.0 : 0.0; \
+		for (unsigned int i = 0; i < n - 1; i++) out[i + n * i] = in[i]; \
+	} \
+	static void run_matrix##n##_comp_epsilon(gmfloat *out, gmfloat *in) { out[0] = gm_matrix##n##x##n##_comp_epsilon(in, in + n * n, fabs(in[2 * n * n])); } \
+	static void ref_matrix##n##_comp_epsilon(gmref *out, gmref *mag, const gmfloat *in) { \
+		out[0] = 1.0; \
+		mag[0] = 1.0; \
+		for (unsigned int i = 0; i < n * n; i++) if (gm_test_distance(in[i], in[n * n + i]) > fabsl(in[2 * n * n])) out[0] = 0.0; \
+	}
+
+GM_TEST_MATRIX(3)
+GM_TEST_MATRIX(4)
+
+static void run_matrix3_rotate(gmfloat *out, gmfloat *in) { gm_matrix3x3_rotate(out, in[0]); }
+static void ref_matrix3_rotate(gmref *out, gmref *mag, const gmfloat *in) {
+	const gmref s = sinl(in[0]), c = cosl(in[0]);
+	const gmref rotate[9] = { c, -s, 0.0, s, c, 0.0, 0.0, 0.0, 1.0 };
+	for (unsigned int i = 0; i < 9; i++) out[i] = rotate[i];
+}
+
+/* Row-major rotation about an axis, the angle's cosine carries into every term through 1 - c. */
+static void run_matrix4_rotate(gmfloat *out, gmfloat *in) { gm_matrix4x4_rotate(out, in[0], in + 1); }
+static void ref_matrix4_rotate(gmref *out, gmref *mag, const gmfloat *in) {
+	const gmref s = sinl(in[0]), c = cosl(in[0]), omc = 1.0 - c;
+	const gmref axis[3] = { in[1], in[2], in[3] };
+
+	for (unsigned int i = 0; i < 16; i++) out[i] = mag[i] = i % 5 == 0 ? 1.0 : 0.0;
+	for (unsigned int i = 0; i < 3; i++) {
+		for (unsigned int j = 0; j < 3; j++) {
+			const unsigned int k = 3 - i - j;
+			gmref sine = 0.0;
+			if (i != j) sine = ((j == (i + 1) % 3) ? -1.0 : 1.0) * axis[k] * s;
+			out[j + 4 * i] = axis[i] * axis[j] * omc + (i == j ? c : 0.0) + sine;
+			mag[j + 4 * i] = fabsl(axis[i] * axis[j]) * (fabsl(omc) + fabsl(c)) + (i == j ? fabsl(c) : 0.0) + fabsl(sine);
+		}
+	}
+}
+
+static void run_matrix4_ortho(gmfloat *out, gmfloat *in) { gm_matrix4x4_ortho(out, in[0], in[1], in[2], in[3], in[4], in[5]); }
+static void ref_matrix4_ortho(gmref *out, gmref *mag, const gmfloat *in) {
+	const gmref l = in[0], r = in[1], b = in[2], t = in[3], n = in[4], f = in[5];
+	for (unsigned int i = 0; i < 16; i++) out[i] = i % 5 == 0 ? 1.0 : 0.0;
+	out[0] = 2.0 / (r - l);
+	out[5] = 2.0 / (t - b);
+	out[10] = 2.0 / (n - f);
+	out[3] = (l + r) / (l - r);
+	out[7] = (b + t) / (b - t);
+	out[11] = (f + n) / (n - f);
+}
+
+static void run_matrix4_perspective(gmfloat *out, gmfloat *in) { gm_matrix4x4_perspective(out, fabs(in[0]) + 0.1, in[1], in[2], in[3]); }
+static void ref_matrix4_perspective(gmref *out, gmref *mag, const gmfloat *in) {
+	const gmref fov = (gmref)(gmfloat)(fabs(in[0]) + 0.1), aspect = in[1], n = in[2], f = in[3];
+	const gmref focal = 1.0 / tanl(fov / 2.0);
+	for (unsigned int i = 0; i < 16; i++) out[i] = 0.0;
+	out[0] = focal / aspect;
+	out[5] = focal;
+	out[10] = (f + n) / (n - f);
+	out[11] = 2.0 * f * n / (n - f);
+	out[14] = -1.0;
+}
+
+/* Scalars */
+
+static void run_comp_epsilon(gmfloat *out, gmfloat *in) { out[0] = gm_comp_epsilon(in[0], in[1], fabs(in[2])); }
+static void ref_comp_epsilon(gmref *out, gmref *mag, const gmfloat *in) {
+	out[0] = gm_test_distance(in[0], in[1]) > fabsl(in[2]) ? 0.0 : 1.0;
+	mag[0] = 1.0;
+}
+
+static void run_conv_deg_rad(gmfloat *out, gmfloat *in) { out[0] = gm_conv_deg_rad(in[0]); }
+static void ref_conv_deg_rad(gmref *out, gmref *mag, const gmfloat *in) { out[0] = (gmref)in[0] * GM_TEST_PI / 180.0; }
+
+static void run_conv_rad_deg(gmfloat *out, gmfloat *in) { out[0] = gm_conv_rad_deg(in[0]); }
+static void ref_conv_rad_deg(gmref *out, gmref *mag, const gmfloat *in) { out[0] = (gmref)in[0] * 180.0 / GM_TEST_PI; }
+
+#define GM_TEST_CASE(name, domain, inputs, outputs, budget) { "gm_" #name, domain, inputs, outputs, budget, run_##name, ref_##name }
+#define GM_TEST_SET(name, n) { "gm_" #name, GM_TEST_FULL, n, n, 0.0, run_##name, ref_copy }
+
+static const gm_test_case gm_test_cases[] = {
+	GM_TEST_SET(vector2, 2),
+	GM_TEST_SET(vector3, 3),
+	GM_TEST_SET(vector4, 4),
+	GM_TEST_CASE(vector2v, GM_TEST_FULL, 1, 2, 0.0),
+	GM_TEST_CASE(vector3v, GM_TEST_FULL, 1, 3, 0.0),
+	GM_TEST_CASE(vector4v, GM_TEST_FULL, 1, 4, 0.0),
+
+	GM_TEST_CASE(vector2_add, GM_TEST_FULL, 4, 2, 0.5),
+	GM_TEST_CASE(vector3_add, GM_TEST_FULL, 6, 3, 0.5),
+	GM_TEST_CASE(vector4_add, GM_TEST_FULL, 8, 4, 0.5),
+	GM_TEST_CASE(vector2_sub, GM_TEST_FULL, 4, 2, 0.5),
+	GM_TEST_CASE(vector3_sub, GM_TEST_FULL, 6, 3, 0.5),
+	GM_TEST_CASE(vector4_sub, GM_TEST_FULL, 8, 4, 0.5),
+	GM_TEST_CASE(vector2_mul, GM_TEST_FULL, 4, 2, 0.5),
+	GM_TEST_CASE(vector3_mul, GM_TEST_FULL, 6, 3, 0.5),
+	GM_TEST_CASE(vector4_mul, GM_TEST_FULL, 8, 4, 0.5),
+	GM_TEST_CASE(vector2_mul_scalar, GM_TEST_FULL, 3, 2, 0.5),
+	GM_TEST_CASE(vector3_mul_scalar, GM_TEST_FULL, 4, 3, 0.5),
+	GM_TEST_CASE(vector4_mul_scalar, GM_TEST_FULL, 5, 4, 0.5),
+
+	GM_TEST_CASE(vector2_dot, GM_TEST_SAFE, 4, 1, 2.0),
+	GM_TEST_CASE(vector3_dot, GM_TEST_SAFE, 6, 1, 3.0),
+	GM_TEST_CASE(vector4_dot, GM_TEST_SAFE, 8, 1, 4.0),
+	GM_TEST_CASE(vector2_cross, GM_TEST_SAFE, 4, 1, 2.0),
+	GM_TEST_CASE(vector3_cross, GM_TEST_SAFE, 6, 3, 2.0),
+	GM_TEST_CASE(vector2_length_sq, GM_TEST_SAFE, 2, 1, 2.0),
+	GM_TEST_CASE(vector3_length_sq, GM_TEST_SAFE, 3, 1, 3.0),
+	GM_TEST_CASE(vector4_length_sq, GM_TEST_SAFE, 4, 1, 4.0),
+	GM_TEST_CASE(vector2_length, GM_TEST_SAFE, 2, 1, 2.0),
+	GM_TEST_CASE(vector3_length, GM_TEST_SAFE, 3, 1, 3.0),
+	GM_TEST_CASE(vector4_length, GM_TEST_SAFE, 4, 1, 4.0),
+	GM_TEST_CASE(vector2_distance, GM_TEST_SAFE, 4, 1, 3.0),
+	GM_TEST_CASE(vector3_distance, GM_TEST_SAFE, 6, 1, 4.0),
+	GM_TEST_CASE(vector4_distance, GM_TEST_SAFE, 8, 1, 5.0),
+	GM_TEST_CASE(vector2_normalized, GM_TEST_SAFE, 2, 2, 3.0),
+	GM_TEST_CASE(vector3_normalized, GM_TEST_SAFE, 3, 3, 4.0),
+	GM_TEST_CASE(vector4_normalized, GM_TEST_SAFE, 4, 4, 5.0),
+
+	GM_TEST_CASE(matrix3v, GM_TEST_FULL, 1, 9, 0.0),
+	GM_TEST_CASE(matrix4v, GM_TEST_FULL, 1, 16, 0.0),
+	GM_TEST_CASE(matrix3vd, GM_TEST_FULL, 1, 9, 0.0),
+	GM_TEST_CASE(matrix4vd, GM_TEST_FULL, 1, 16, 0.0),
+	GM_TEST_CASE(matrix4_ortho, GM_TEST_SAFE, 6, 16, 3.0),
+	GM_TEST_CASE(matrix4_perspective, GM_TEST_SAFE, 4, 16, 3.0),
+	GM_TEST_CASE(matrix3_translate, GM_TEST_FULL, 2, 9, 0.0),
+	GM_TEST_CASE(matrix4_translate, GM_TEST_FULL, 3, 16, 0.0),
+	GM_TEST_CASE(matrix3_scale, GM_TEST_FULL, 2, 9, 0.0),
+	GM_TEST_CASE(matrix4_scale, GM_TEST_FULL, 3, 16, 0.0),
+	GM_TEST_CASE(matrix3_rotate, GM_TEST_ANGLE, 1, 9, 1.0),
+	GM_TEST_CASE(matrix4_rotate, GM_TEST_ANGLE, 4, 16, 4.0),
+
+	GM_TEST_CASE(matrix3_add, GM_TEST_FULL, 18, 9, 0.5),
+	GM_TEST_CASE(matrix4_add, GM_TEST_FULL, 32, 16, 0.5),
+	GM_TEST_CASE(matrix3_sub, GM_TEST_FULL, 18, 9, 0.5),
+	GM_TEST_CASE(matrix4_sub, GM_TEST_FULL, 32, 16, 0.5),
+	GM_TEST_CASE(matrix3_mul, GM_TEST_SAFE, 18, 9, 3.0),
+	GM_TEST_CASE(matrix4_mul, GM_TEST_SAFE, 32, 16, 4.0),
+	GM_TEST_CASE(matrix3_mul_scalar, GM_TEST_FULL, 10, 9, 0.5),
+	GM_TEST_CASE(matrix4_mul_scalar, GM_TEST_FULL, 17, 16, 0.5),
+	GM_TEST_CASE(matrix3_mul_vector, GM_TEST_SAFE, 12, 3, 3.0),
+	GM_TEST_CASE(matrix4_mul_vector, GM_TEST_SAFE, 20, 4, 4.0),
+	GM_TEST_CASE(matrix3_transpose, GM_TEST_FULL, 9, 9, 0.0),
+	GM_TEST_CASE(matrix4_transpose, GM_TEST_FULL, 16, 16, 0.0),
+
+	GM_TEST_CASE(comp_epsilon, GM_TEST_SAFE, 3, 1, 0.0),
+	GM_TEST_CASE(vector2_comp_epsilon, GM_TEST_SAFE, 5, 1, 0.0),
+	GM_TEST_CASE(vector3_comp_epsilon, GM_TEST_SAFE, 7, 1, 0.0),
+	GM_TEST_CASE(vector4_comp_epsilon, GM_TEST_SAFE, 9, 1, 0.0),
+	GM_TEST_CASE(matrix3_comp_epsilon, GM_TEST_SAFE, 19, 1, 0.0),
+	GM_TEST_CASE(matrix4_comp_epsilon, GM_TEST_SAFE, 33, 1, 0.0),
+	GM_TEST_CASE(conv_deg_rad, GM_TEST_SAFE, 1, 1, 1.0),
+	GM_TEST_CASE(conv_rad_deg, GM_TEST_SAFE, 1, 1, 1.0),
+};
+
+static void gm_test_fixed(void) {
+	static gmfloat in[GM_TEST_SAMPLES][GM_TEST_MAX_IN];
+	static gmfloat out[GM_TEST_SAMPLES][GM_TEST_MAX_OUT];
+
+	gm_test_header("Fixed size functions");
+	for (unsigned int c = 0; c < sizeof(gm_test_cases) / sizeof(gm_test_cases[0]); c++) {
+		const gm_test_case *test = &gm_test_cases[c];
+		double max = 0.0, sum = 0.0;
+
+		for (unsigned int s = 0; s < GM_TEST_SAMPLES; s++) {
+			for (unsigned int i = 0; i < GM_TEST_MAX_IN; i++) {
+				in[s][i] = i < test->inputs ? gm_test_value(test->domain) : 0.0;
+			}
+		}
+
+		for (unsigned int s = 0; s < GM_TEST_SAMPLES; s++) {
+			gmref ref[GM_TEST_MAX_OUT] = { 0.0 }, mag[GM_TEST_MAX_OUT] = { 0.0 };
+			test->run(out[s], in[s]);
+			test->ref(ref, mag, in[s]);
+
+			for (unsigned int i = 0; i < test->outputs; i++) {
+				const double err = gm_test_ulp(out[s][i], ref[i], mag[i]);
+				if (err > max) max = err;
+				sum += err;
+			}
+		}
+
+		/* Time the whole sample set until the clock is well above its resolution. */
+		unsigned long long calls = 0;
+		const double start = gm_test_time();
+		double elapsed;
+		do {
+			for (unsigned int s = 0; s < GM_TEST_SAMPLES; s++) {
+				test->run(out[s], in[s]);
+			}
+			calls += GM_TEST_SAMPLES;
+			elapsed = gm_test_time() - start;
+		} while (elapsed < GM_TEST_MIN_TIME);
+
+		gm_test_report(test->name, "-", max, sum / ((double)GM_TEST_SAMPLES * test->outputs), test->budget, calls / elapsed * 1e-6, "Mcall/s");
+	}
+}
+
+/* ---- Dynamic matrices ----
+Every instruction set variant the host supports runs against the same inputs and reference. Inputs
+are uniform in [-1, 1]; errors are relative to the sum of the term magnitudes. */
+
+#define GM_TEST_ISA_COUNT (GM_ISA_AVX512 + 1)
+
+typedef struct {
+	const char *name;
+	double rate[GM_TEST_ISA_COUNT];
+	gmboolean pass[GM_TEST_ISA_COUNT];
+} gm_test_variant;
+
+static void gm_test_fill(matrixn *mat) {
+	for (size_t i = 0; i < (size_t)mat->rows * mat->cols; i++) {
+		mat->data[i] = gm_test_uniform(-1.0, 1.0);
+	}
+}
+
+static void gm_test_gemm(gm_test_variant *variant, unsigned int m, unsigned int n, unsigned int k) {
+	char name[64];
+	snprintf(name, sizeof(name), "gm_matrixn_mul %ux%ux%u", m, n, k);
+
+	matrixn a, b, c;
+	gmboolean allocated = gm_matrixn_create(&a, m, k);
+	allocated &= gm_matrixn_create(&b, k, n);
+	allocated &= gm_matrixn_create(&c, m, n);
+	gmref *ref = malloc(sizeof(gmref) * m * n), *mag = malloc(sizeof(gmref) * m * n);
+	if (gm_test_allocated(name, allocated && ref != NULL && mag != NULL) == GM_TRUE) {
+		gm_test_fill(&a);
+		gm_test_fill(&b);
+
+		for (unsigned int j = 0; j < n; j++) {
+			for (unsigned int i = 0; i < m; i++) {
+				gmref sum = 0.0, abs = 0.0;
+				for (unsigned int p = 0; p < k; p++) {
+					const gmref term = (gmref)gm_matrixn_at(&a, i, p) * gm_matrixn_at(&b, p, j);
+					sum += term;
+					abs += fabsl(term);
+				}
+				ref[i + (size_t)m * j] = sum;
+				mag[i + (size_t)m * j] = abs;
+			}
+		}
+
+		for (gmisa isa = GM_ISA_GENERIC; isa < GM_TEST_ISA_COUNT; isa++) {
+			if (gm_isa_select(isa) != GM_TRUE) continue;
+
+			const gmboolean computed = gm_matrixn_mul(&c, &a, &b);
+			double max = computed ? 0.0 : INFINITY, sum = 0.0;
+			for (size_t i = 0; i < (size_t)m * n; i++) {
+				const double err = gm_test_ulp(c.data[i], ref[i], mag[i]);
+				if (err > max) max = err;
+				sum += err;
+			}
+
+			unsigned int runs = 0;
+			const double start = gm_test_time();
+			double elapsed;
+			do {
+				gm_matrixn_mul(&c, &a, &b);
+				runs++;
+				elapsed = gm_test_time() - start;
+			} while (elapsed < GM_TEST_MIN_TIME);
+
+			const double rate = 2.0 * m * n * k * runs / elapsed * 1e-9;
+			variant->pass[isa] &= gm_test_report(name, gm_isa_name(isa), max, sum / ((double)m * n), k, rate, "GFLOPS");
+			if (rate > variant->rate[isa]) variant->rate[isa] = rate;
+		}
+	}
+
+	free(ref);
+	free(mag);
+	gm_matrixn_destroy(&a);
+	gm_matrixn_destroy(&b);
+	gm_matrixn_destroy(&c);
+}
+
+static void gm_test_gemv(gm_test_variant *variant, unsigned int m, unsigned int n) {
+	char name[64];
+	snprintf(name, sizeof(name), "gm_matrixn_mul_vector %ux%u", m, n);
+
+	matrixn a;
+	const gmboolean allocated = gm_matrixn_create(&a, m, n);
+	gmfloat *vec = malloc(sizeof(gmfloat) * n), *dest = malloc(sizeof(gmfloat) * m);
+	gmref *ref = malloc(sizeof(gmref) * m), *mag = malloc(sizeof(gmref) * m);
+	if (gm_test_allocated(name, allocated && vec != NULL && dest != NULL && ref != NULL && mag != NULL) == GM_TRUE) {
+		gm_test_fill(&a);
+		for (unsigned int j = 0; j < n; j++) vec[j] = gm_test_uniform(-1.0, 1.0);
+		for (unsigned int i = 0; i < m; i++) {
+			ref[i] = mag[i] = 0.0;
+			for (unsigned int j = 0; j < n; j++) {
+				ref[i] += (gmref)gm_matrixn_at(&a, i, j) * vec[j];
+				mag[i] += fabsl((gmref)gm_matrixn_at(&a, i, j) * vec[j]);
+			}
+		}
+
+		for (gmisa isa = GM_ISA_GENERIC; isa < GM_TEST_ISA_COUNT; isa++) {
+			if (gm_isa_select(isa) != GM_TRUE) continue;
+
+			gm_matrixn_mul_vector(dest, &a, vec);
+			double max = 0.0, sum = 0.0;
+			for (unsigned int i = 0; i < m; i++) {
+				const double err = gm_test_ulp(dest[i], ref[i], mag[i]);
+				if (err > max) max = err;
+				sum += err;
+			}
+
+			unsigned int runs = 0;
+			const double start = gm_test_time();
+			double elapsed;
+			do {
+				gm_matrixn_mul_vector(dest, &a, vec);
+				runs++;
+				elapsed = gm_test_time() - start;
+			} while (elapsed < GM_TEST_MIN_TIME);
+
+			const double rate = 2.0 * m * n * runs / elapsed * 1e-9;
+			variant->pass[isa] &= gm_test_report(name, gm_isa_name(isa), max, sum / m, n, rate, "GFLOPS");
+			if (rate > variant->rate[isa]) variant->rate[isa] = rate;
+		}
+	}
+
+	free(vec);
+	free(dest);
+	free(ref);
+	free(mag);
+	gm_matrixn_destroy(&a);
+}
+
+/* Solve a system with a known solution. Diagonally dominant systems never swap rows, the error is
+relative to max |x|. Random systems have to pivot and are checked by the residual A * x - b against
+the magnitude of its terms, as their solution is only as accurate as the matrix is conditioned. */
+static void gm_test_lu(gm_test_variant *variant, unsigned int n, gmboolean dominant) {
+	char name[64];
+	snprintf(name, sizeof(name), dominant ? "gm_matrixn_lu+solve %u" : "gm_matrixn_lu pivoting %u", n);
+
+	matrixn a, lu;
+	gmboolean allocated = gm_matrixn_create(&a, n, n);
+	allocated &= gm_matrixn_create(&lu, n, n);
+	gmfloat *x = malloc(sizeof(gmfloat) * n), *b = malloc(sizeof(gmfloat) * n), *vec = malloc(sizeof(gmfloat) * n);
+	unsigned int *pivot = malloc(sizeof(unsigned int) * n);
+	if (gm_test_allocated(name, allocated && x != NULL && b != NULL && vec != NULL && pivot != NULL) == GM_TRUE) {
+		gm_test_fill(&a);
+		if (dominant) {
+			for (unsigned int i = 0; i < n; i++) gm_matrixn_at(&a, i, i) += n;
+		}
+
+		gmref scale = 0.0;
+		for (unsigned int i = 0; i < n; i++) {
+			x[i] = gm_test_uniform(-1.0, 1.0);
+			if (fabsl(x[i]) > scale) scale = fabsl(x[i]);
+		}
+		for (unsigned int i = 0; i < n; i++) {
+			gmref sum = 0.0;
+			for (unsigned int j = 0; j < n; j++) sum += (gmref)gm_matrixn_at(&a, i, j) * x[j];
+			b[i] = sum;
+		}
+
+		for (gmisa isa = GM_ISA_GENERIC; isa < GM_TEST_ISA_COUNT; isa++) {
+			if (gm_isa_select(isa) != GM_TRUE) continue;
+
+			unsigned int runs = 0;
+			gmboolean factored = GM_TRUE;
+			const double start = gm_test_time();
+			double elapsed;
+			do {
+				memcpy(lu.data, a.data, sizeof(gmfloat) * n * n);
+				factored &= gm_matrixn_lu(&lu, pivot);
+				runs++;
+				elapsed = gm_test_time() - start;
+			} while (elapsed < GM_TEST_MIN_TIME);
+
+			memcpy(vec, b, sizeof(gmfloat) * n);
+			gm_matrixn_solve(&lu, pivot, vec);
+			double max = factored ? 0.0 : INFINITY, sum = 0.0;
+			if (dominant) {
+				for (unsigned int i = 0; i < n; i++) {
+					const double err = gm_test_ulp(vec[i], x[i], scale);
+					if (err > max) max = err;
+					sum += err;
+				}
+			} else {
+				/* A factorization that never swapped rows did not test the pivoting. */
+				unsigned int swaps = 0;
+				for (unsigned int i = 0; i < n; i++) swaps += pivot[i] != i;
+				if (swaps == 0) max = INFINITY;
+
+				for (unsigned int i = 0; i < n; i++) {
+					gmref ax = 0.0, mag = 0.0;
+					for (unsigned int j = 0; j < n; j++) {
+						ax += (gmref)gm_matrixn_at(&a, i, j) * vec[j];
+						mag += fabsl((gmref)gm_matrixn_at(&a, i, j) * vec[j]);
+					}
+					const double err = gm_test_ulp(b[i], ax, mag);
+					if (err > max) max = err;
+					sum += err;
+				}
+			}
+
+			const double rate = 2.0 / 3.0 * n * n * n * runs / elapsed * 1e-9;
+			variant->pass[isa] &= gm_test_report(name, gm_isa_name(isa), max, sum / n, n, rate, "GFLOPS");
+			if (rate > variant->rate[isa]) variant->rate[isa] = rate;
+		}
+	}
+
+	free(x);
+	free(b);
+	free(vec);
+	free(pivot);
+	gm_matrixn_destroy(&a);
+	gm_matrixn_destroy(&lu);
+}
+
+/* A random matrix with a zero row is singular however the rows are swapped, the zero pivot only
+shows up in the last column. */
+static void gm_test_lu_singular(gm_test_variant *variant, unsigned int n) {
+	char name[64];
+	snprintf(name, sizeof(name), "gm_matrixn_lu singular %u", n);
+
+	matrixn a, lu;
+	gmboolean allocated = gm_matrixn_create(&a, n, n);
+	allocated &= gm_matrixn_create(&lu, n, n);
+	unsigned int *pivot = malloc(sizeof(unsigned int) * n);
+	if (gm_test_allocated(name, allocated && pivot != NULL) == GM_TRUE) {
+		gm_test_fill(&a);
+		for (unsigned int j = 0; j < n; j++) gm_matrixn_at(&a, 0, j) = 0.0;
+
+		for (gmisa isa = GM_ISA_GENERIC; isa < GM_TEST_ISA_COUNT; isa++) {
+			if (gm_isa_select(isa) != GM_TRUE) continue;
+
+			memcpy(lu.data, a.data, sizeof(gmfloat) * n * n);
+			const double max = gm_matrixn_lu(&lu, pivot) == GM_FALSE ? 0.0 : INFINITY;
+			variant->pass[isa] &= gm_test_report(name, gm_isa_name(isa), max, max, 0.0, 0.0, "-");
+		}
+	}
+
+	free(pivot);
+	gm_matrixn_destroy(&a);
+	gm_matrixn_destroy(&lu);
+}
+
+static void gm_test_transpose(unsigned int m, unsigned int n) {
+	char name[64];
+	snprintf(name, sizeof(name), "gm_matrixn_transpose %ux%u", m, n);
+
+	matrixn a, t;
+	gmboolean allocated = gm_matrixn_create(&a, m, n);
+	allocated &= gm_matrixn_create(&t, n, m);
+	if (gm_test_allocated(name, allocated) == GM_TRUE) {
+		gm_test_fill(&a);
+
+		unsigned int runs = 0;
+		const double start = gm_test_time();
+		double elapsed;
+		do {
+			gm_matrixn_transpose(&t, &a);
+			runs++;
+			elapsed = gm_test_time() - start;
+		} while (elapsed < GM_TEST_MIN_TIME);
+
+		double max = 0.0;
+		for (unsigned int i = 0; i < m; i++) {
+			for (unsigned int j = 0; j < n; j++) {
+				const double err = gm_test_ulp(gm_matrixn_at(&t, j, i), gm_matrixn_at(&a, i, j), 0.0);
+				if (err > max) max = err;
+			}
+		}
+
+		gm_test_report(name, "-", max, max, 0.0, (double)m * n * runs / elapsed * 1e-6, "Melem/s");
+	}
+
+	gm_matrixn_destroy(&a);
+	gm_matrixn_destroy(&t);
+}
+
+/* Name the fastest variant of each dispatched function that stayed within its error budget. */
+static void gm_test_pick(const gm_test_variant *variant) {
+	int best = -1;
+	for (int isa = 0; isa < GM_TEST_ISA_COUNT; isa++) {
+		if (variant->pass[isa] && variant->rate[isa] > 0.0 && (best < 0 || variant->rate[isa] > variant->rate[best])) best = isa;
+	}
+	printf("%-28s %s\n", variant->name, best < 0 ? "none within budget" : gm_isa_name(best));
+}
+
+static void gm_test_dynamic(void) {
+	const gmisa selected = gm_isa();
+	gm_test_variant gemm = { "gm_matrixn_mul", { 0.0 }, { GM_TRUE, GM_TRUE, GM_TRUE, GM_TRUE } };
+	gm_test_variant gemv = { "gm_matrixn_mul_vector", { 0.0 }, { GM_TRUE, GM_TRUE, GM_TRUE, GM_TRUE } };
+	gm_test_variant lu = { "gm_matrixn_lu", { 0.0 }, { GM_TRUE, GM_TRUE, GM_TRUE, GM_TRUE } };
+
+	gm_test_header("Dynamic matrices");
+	gm_test_gemm(&gemm, 1, 1, 1);
+	gm_test_gemm(&gemm, 7, 5, 3);
+	gm_test_gemm(&gemm, 33, 17, 65);
+	gm_test_gemm(&gemm, 130, 257, 96);
+	gm_test_gemm(&gemm, 300, 300, 300);
+	gm_test_gemv(&gemv, 3, 7);
+	gm_test_gemv(&gemv, 513, 257);
+	gm_test_lu(&lu, 5, GM_TRUE);
+	gm_test_lu(&lu, 200, GM_TRUE);
+	gm_test_lu(&lu, 63, GM_FALSE);
+	gm_test_lu(&lu, 64, GM_FALSE);
+	gm_test_lu(&lu, 65, GM_FALSE);
+	gm_test_lu(&lu, 200, GM_FALSE);
+	gm_test_lu_singular(&lu, 130);
+	gm_test_transpose(97, 513);
+
+	printf("\nFastest variant within budget\n");
+	gm_test_pick(&gemm);
+	gm_test_pick(&gemv);
+	gm_test_pick(&lu);
+
+	/* Products large enough to be split between threads, including the trailing updates of LU. These
+	rows repeat the single threaded ones in builds without GM_USE_THREADS. */
+	for (unsigned int threads = 2; threads <= 4; threads++) {
+		gm_test_variant split = { "gm_matrixn_mul", { 0.0 }, { GM_TRUE, GM_TRUE, GM_TRUE, GM_TRUE } };
+		char title[64];
+		snprintf(title, sizeof(title), "Dynamic matrices, %u threads", threads);
+
+		gm_matrixn_threads(threads);
+		gm_test_header(title);
+		gm_test_gemm(&split, 130, 257, 96);
+		gm_test_gemm(&split, 300, 300, 300);
+		gm_test_lu(&split, 200, GM_TRUE);
+		gm_test_lu(&split, 200, GM_FALSE);
+	}
+	gm_matrixn_threads(1);
+
+	gm_isa_select(selected);
+}
+
+/* ---- Keyframe tracks ----
+Tracks with 0 to 12 keys at random spacing, sampled by forward playback, a jump back and random
+seeks. The reference finds each segment from scratch and evaluates it in long double. */
+
+#define GM_TEST_TRACKS 10000
+#define GM_TEST_FRAMES 64
+#define GM_TEST_SEEKS 16
+
+static gmboolean gm_test_track_build(vector3tracks *tracks) {
+	unsigned int keys[GM_TEST_TRACKS];
+	for (unsigned int i = 0; i < GM_TEST_TRACKS; i++) keys[i] = gm_test_rand() % 13;
+	if (gm_vector3tracks_create(tracks, GM_TEST_TRACKS, keys, GM_TRUE) != GM_TRUE) return GM_FALSE;
+
+	for (unsigned int i = 0; i < GM_TEST_TRACKS; i++) {
+		gmfloat time = gm_test_uniform(0.0, 0.5);
+		for (unsigned int k = 0; k < keys[i]; k++) {
+			gm_vector3tracks_time(tracks, i, k) = time;
+			time += gm_test_uniform(0.05, 0.5);
+			for (unsigned int c = 0; c < 3; c++) {
+				gm_vector3tracks_value(tracks, i, k)[c] = gm_test_uniform(-100.0, 100.0);
+				gm_vector3tracks_tangent(tracks, i, k)[c] = gm_test_uniform(-100.0, 100.0);
+			}
+		}
+	}
+	return GM_TRUE;
+}
+
+static void gm_test_track_ref(vector3tracks *tracks, unsigned int track, gmfloat time, gminterp mode, gmref *out, gmref *mag) {
+	const unsigned int keys = gm_vector3tracks_keys(tracks, track);
+	unsigned int k = 0;
+	gmref s = 0.0;
+
+	for (unsigned int c = 0; c < 3; c++) out[c] = mag[c] = 0.0;
+	if (keys == 0) return;
+	while (k + 1 < keys && gm_vector3tracks_time(tracks, track, k + 1) <= time) k++;
+	if (k + 1 == keys || time <= gm_vector3tracks_time(tracks, track, 0)) {
+		for (unsigned int c = 0; c < 3; c++) out[c] = mag[c] = gm_vector3tracks_value(tracks, track, time <= gm_vector3tracks_time(tracks, track, 0) ? 0 : k)[c];
+		return;
+	}
+
+	const gmref t0 = gm_vector3tracks_time(tracks, track, k), t1 = gm_vector3tracks_time(tracks, track, k + 1);
+	const unsigned int prev = k > 0 ? k - 1 : k, next = k + 2 < keys ? k + 2 : k + 1;
+	s = ((gmref)time - t0) / (t1 - t0);
+
+	const gmref h00 = 2.0 * s * s * s - 3.0 * s * s + 1.0, h01 = 3.0 * s * s - 2.0 * s * s * s;
+	const gmref h10 = s * s * s - 2.0 * s * s + s, h11 = s * s * s - s * s;
+	for (unsigned int c = 0; c < 3; c++) {
+		const gmref p0 = gm_vector3tracks_value(tracks, track, k)[c], p1 = gm_vector3tracks_value(tracks, track, k + 1)[c];
+		gmref m0, m1;
+
+		if (mode == GM_INTERP_LINEAR) {
+			out[c] = p0 * (1.0 - s) + p1 * s;
+			mag[c] = fabsl(p0) + fabsl(p1);
+			continue;
+		} else if (mode == GM_INTERP_HERMITE) {
+			m0 = gm_vector3tracks_tangent(tracks, track, k)[c] * (t1 - t0);
+			m1 = gm_vector3tracks_tangent(tracks, track, k + 1)[c] * (t1 - t0);
+			mag[c] = fabsl(p0) + fabsl(p1) + fabsl(m0) + fabsl(m1);
+		} else {
+			const gmref before = gm_vector3tracks_value(tracks, track, prev)[c], after = gm_vector3tracks_value(tracks, track, next)[c];
+			const gmref w0 = (t1 - t0) / (t1 - gm_vector3tracks_time(tracks, track, prev));
+			const gmref w1 = (t1 - t0) / (gm_vector3tracks_time(tracks, track, next) - t0);
+			m0 = (p1 - before) * w0;
+			m1 = (after - p0) * w1;
+			mag[c] = fabsl(p0) + fabsl(p1) + (fabsl(p1) + fabsl(before)) * w0 + (fabsl(after) + fabsl(p0)) * w1;
+		}
+		out[c] = p0 * h00 + p1 * h01 + m0 * h10 + m1 * h11;
+	}
+}
+
+/* The per vector loop the batched sampler replaces, kept as a throughput baseline. */
+static void gm_test_track_loop(vector3tracks *tracks, gmfloat time, vector3 *dest) {
+	for (unsigned int i = 0; i < tracks->count; i++) {
+		const unsigned int keys = gm_vector3tracks_keys(tracks, i);
+		unsigned int k = 0;
+		gm_vector3v(dest[i], 0.0);
+		if (keys == 0) continue;
+
+		while (k + 1 < keys && gm_vector3tracks_time(tracks, i, k + 1) <= time) k++;
+		if (k + 1 == keys || time <= gm_vector3tracks_time(tracks, i, 0)) {
+			gm_vector3_add(dest[i], gm_vector3tracks_value(tracks, i, time <= gm_vector3tracks_time(tracks, i, 0) ? 0 : k));
+			continue;
+		}
+
+		const gmfloat s = (time - gm_vector3tracks_time(tracks, i, k)) / (gm_vector3tracks_time(tracks, i, k + 1) - gm_vector3tracks_time(tracks, i, k));
+		vector3 b;
+		gm_vector3_add(dest[i], gm_vector3tracks_value(tracks, i, k));
+		gm_vector3v(b, 0.0);
+		gm_vector3_add(b, gm_vector3tracks_value(tracks, i, k + 1));
+		gm_vector3_mul_scalar(dest[i], 1.0 - s);
+		gm_vector3_mul_scalar(b, s);
+		gm_vector3_add(dest[i], b);
+	}
+}
+
+static void gm_test_tracks(void) {
+	const char *names[] = { "gm_vector3tracks linear", "gm_vector3tracks catmull-rom", "gm_vector3tracks hermite" };
+	const double budgets[] = { 4.0, 8.0, 8.0 };
+	gmfloat times[GM_TEST_FRAMES + GM_TEST_SEEKS];
+	vector3tracks tracks;
+	const gmboolean allocated = gm_test_track_build(&tracks);
+	vector3 *dest = malloc(sizeof(vector3) * GM_TEST_TRACKS);
+
+	gm_test_header("Keyframe tracks");
+	if (gm_test_allocated("gm_vector3tracks", allocated && dest != NULL) != GM_TRUE) {
+		gm_vector3tracks_destroy(&tracks);
+		free(dest);
+		return;
+	}
+
+	for (unsigned int f = 0; f < GM_TEST_FRAMES; f++) times[f] = -0.2 + 6.4 * f / GM_TEST_FRAMES;
+	times[GM_TEST_FRAMES] = 1.0;
+	for (unsigned int f = GM_TEST_FRAMES + 1; f < GM_TEST_FRAMES + GM_TEST_SEEKS; f++) times[f] = gm_test_uniform(-0.5, 6.5);
+
+	for (int mode = GM_INTERP_LINEAR; mode <= GM_INTERP_HERMITE; mode++) {
+		double max = 0.0, sum = 0.0;
+		gm_vector3tracks_rewind(&tracks);
+		for (unsigned int f = 0; f < GM_TEST_FRAMES + GM_TEST_SEEKS; f++) {
+			gm_vector3tracks_sample(&tracks, times[f], mode, dest);
+			for (unsigned int i = 0; i < GM_TEST_TRACKS; i++) {
+				gmref ref[3], mag[3];
+				gm_test_track_ref(&tracks, i, times[f], mode, ref, mag);
+				for (unsigned int c = 0; c < 3; c++) {
+					const double err = gm_test_ulp(dest[i][c], ref[c], mag[c]);
+					if (err > max) max = err;
+					sum += err;
+				}
+			}
+		}
+
+		unsigned long long samples = 0;
+		const double start = gm_test_time();
+		double elapsed;
+		do {
+			for (unsigned int f = 0; f < GM_TEST_FRAMES; f++) {
+				gm_vector3tracks_sample(&tracks, times[f], mode, dest);
+			}
+			samples += (unsigned long long)GM_TEST_FRAMES * GM_TEST_TRACKS;
+			elapsed = gm_test_time() - start;
+		} while (elapsed < GM_TEST_MIN_TIME);
+
+		gm_test_report(names[mode], "-", max, sum / (3.0 * GM_TEST_TRACKS * (GM_TEST_FRAMES + GM_TEST_SEEKS)), budgets[mode], samples / elapsed * 1e-6, "Msmp/s");
+	}
+
+	/* Baseline: one vector at a time with the fixed size vector functions. */
+	double max = 0.0, sum = 0.0;
+	for (unsigned int f = 0; f < GM_TEST_FRAMES + GM_TEST_SEEKS; f++) {
+		gm_test_track_loop(&tracks, times[f], dest);
+		for (unsigned int i = 0; i < GM_TEST_TRACKS; i++) {
+			gmref ref[3], mag[3];
+			gm_test_track_ref(&tracks, i, times[f], GM_INTERP_LINEAR, ref, mag);
+			for (unsigned int c = 0; c < 3; c++) {
+				const double err = gm_test_ulp(dest[i][c], ref[c], mag[c]);
+				if (err > max) max = err;
+				sum += err;
+			}
+		}
+	}
+
+	unsigned long long samples = 0;
+	const double start = gm_test_time();
+	double elapsed;
+	do {
+		for (unsigned int f = 0; f < GM_TEST_FRAMES; f++) {
+			gm_test_track_loop(&tracks, times[f], dest);
+		}
+		samples += (unsigned long long)GM_TEST_FRAMES * GM_TEST_TRACKS;
+		elapsed = gm_test_time() - start;
+	} while (elapsed < GM_TEST_MIN_TIME);
+	gm_test_report("gm_vector3 linear loop", "-", max, sum / (3.0 * GM_TEST_TRACKS * (GM_TEST_FRAMES + GM_TEST_SEEKS)), budgets[GM_INTERP_LINEAR], samples / elapsed * 1e-6, "Msmp/s");
+
+	gm_vector3tracks_destroy(&tracks);
+	free(dest);
+}
+
+int main(void) {
+	printf("GMath accuracy and throughput, host instruction set: %s\n", gm_isa_name(gm_isa()));
+
+	gm_test_fixed();
+	gm_test_dynamic();
+	gm_test_tracks();
+
+	printf("\n%d failure(s)\n", gm_test_failures);
+	return gm_test_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*** end of file ***/